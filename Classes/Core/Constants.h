@@ -57,6 +57,14 @@ namespace Constants {
         constexpr int PROJECTILE_SPEED = 500;
     }
     
+    // 敌人 AI 分级（LOD）
+    namespace AI {
+        constexpr float SCREEN_MARGIN = 64.0f;     // 视口外扩像素，范围内视为在屏幕上
+        constexpr float ATTACK_MARGIN = 40.0f;     // 攻击范围外扩，范围内始终全速
+        constexpr int REDUCED_INTERVAL = 4;        // 远处敌人每 N 帧执行一次 AI（按槽位错开）
+        constexpr int FULL_RATE_BUDGET = 40;       // 每帧全速 AI 上限，超出时屏幕内离玩家较远的降为低频（攻击范围内的不降级）
+    }
+    
     // 资源路径
     namespace Path {
         // 场景
@@ -70,6 +70,25 @@ enum class EnemyType {
     BOSS         // Boss
 };
 
+// 敌人种类（每个敌人类一项，构造时写入实体，用于替代 RTTI 判断类型）
+// 顺序与 EnemyKinds::TABLE 一致
+enum class EnemyKind : unsigned char {
+    GENERIC,        // Enemy 基类
+    AYAO,           // 阿咬
+    DEYI,           // 得意
+    XINXING,        // 新星
+    TANGHUANG,      // 堂皇
+    DU,             // 妒
+    CUP,            // 魂灵圣杯
+    BOAT,           // 船
+    KONGKAZI,       // 恐卡兹
+    IRON_LANCE,     // 铁枪
+    IRON_LIGHT_CUP, // 铁光杯
+    NILU_FIRE,      // 尼卢火
+    KUILONG_BOSS,   // 傀龙 Boss
+    COUNT
+};
+
 // 数学工具宏
 #define DEG_TO_RAD(deg) ((deg) * M_PI / 180.0f)
 #define RAD_TO_DEG(rad) ((rad) * 180.0f / M_PI)
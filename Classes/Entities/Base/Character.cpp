@@ -1,11 +1,12 @@
 ﻿#include "Character.h"
+#include "EntityStore.h"
 
 Character::Character()
     : _currentState(EntityState::IDLE)
     , _moveSpeed(Constants::Player::DEFAULT_MOVE_SPEED)
     , _attack(10)
     , _attackCooldown(Constants::Combat::ATTACK_COOLDOWN)
-    , _attackCooldownTimer(0.0f)
+    , _attackCooldownTimer(EntityStore::getInstance()->cooldown(_storeSlot).attackTimer)
     , _mp(Constants::Player::DEFAULT_MP)
     , _maxMP(Constants::Player::DEFAULT_MP)
     , _facingDirection(Vec2(1, 0))
@@ -38,12 +39,6 @@ void Character::update(float dt)
     
     // 更新状态机
     updateStateMachine(dt);
-    
-    // 更新攻击冷却
-    if (_attackCooldownTimer > 0)
-    {
-        _attackCooldownTimer -= dt;
-    }
 }
 
 void Character::setState(EntityState state)
@@ -85,7 +85,7 @@ protected:
     int _attack;                   // 攻击力
     
     float _attackCooldown;         // 攻击冷却时间
-    float _attackCooldownTimer;    // 攻击冷却计时器
+    float& _attackCooldownTimer;   // 攻击冷却计时器（引用 EntityStore，由 tickTimers 统一递减）
     
     int _mp;                       // 当前法力值
     int _maxMP;                    // 最大法力值
@@ -0,0 +1,111 @@
+﻿#include "DamageQueue.h"
+#include "GameEntity.h"
+#include "EntityStore.h"
+#include "UI/FloatingText.h"
+
+USING_NS_CC;
+
+DamageQueue* DamageQueue::_instance = nullptr;
+
+DamageQueue* DamageQueue::getInstance()
+{
+    if (!_instance)
+    {
+        _instance = new DamageQueue();
+    }
+    return _instance;
+}
+
+void DamageQueue::destroyInstance()
+{
+    delete _instance;
+    _instance = nullptr;
+}
+
+DamageQueue::DamageQueue()
+    : _resolving(false)
+{
+}
+
+DamageQueue::~DamageQueue()
+{
+    clear();
+}
+
+void DamageQueue::push(GameEntity* target, int amount, const Color3B& textColor, bool showText)
+{
+    if (!target || amount <= 0) return;
+
+    target->retain();
+    _events.push_back(DamageEvent{ target, amount, textColor, showText });
+}
+
+int DamageQueue::resolve()
+{
+    if (_resolving || _events.empty()) return 0;
+    _resolving = true;
+
+    // 结算中可能追加事件，按下标遍历并每次复制出当前事件
+    size_t index = 0;
+    for (; index < _events.size(); index++)
+    {
+        DamageEvent event = _events[index];
+        GameEntity* target = event.target;
+
+        auto found = _textIndex.find(target);
+        if (found == _textIndex.end())
+        {
+            Node* parent = target->getParent();
+            if (parent) parent->retain();
+            found = _textIndex.emplace(target, static_cast<int>(_texts.size())).first;
+            _texts.push_back(HitText{ parent, target->getPosition(), event.textColor, 0, false });
+        }
+
+        // 不在模拟中的目标（已离开场景、或所属场景已挂起）不再结算
+        if (!target->isDead() && EntityStore::getInstance()->isActive(target->getStoreSlot()))
+        {
+            int oldHP = target->getHP();
+            target->takeDamage(event.amount);
+            int applied = oldHP - target->getHP();
+            if (applied > 0)
+            {
+                HitText& text = _texts[found->second];
+                text.applied += applied;
+                text.show = text.show || event.showText;
+            }
+        }
+    }
+
+    for (auto& text : _texts)
+    {
+        if (text.parent)
+        {
+            if (text.show && text.applied > 0)
+            {
+                FloatingText::show(text.parent, text.position, std::to_string(text.applied), text.color);
+            }
+            text.parent->release();
+        }
+    }
+
+    for (auto& event : _events)
+    {
+        event.target->release();
+    }
+
+    int resolved = static_cast<int>(index);
+    _events.clear();
+    _texts.clear();
+    _textIndex.clear();
+    _resolving = false;
+    return resolved;
+}
+
+void DamageQueue::clear()
+{
+    for (auto& event : _events)
+    {
+        event.target->release();
+    }
+    _events.clear();
+}
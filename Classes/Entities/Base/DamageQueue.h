@@ -0,0 +1,63 @@
+﻿#ifndef __DAMAGE_QUEUE_H__
+#define __DAMAGE_QUEUE_H__
+
+#include "cocos2d.h"
+#include <vector>
+#include <unordered_map>
+
+class GameEntity;
+
+// 伤害事件队列
+// 玩法伤害（子弹、爆炸、近战、地刺、自爆、状态跳伤等）不在命中处直接扣血，
+// 而是排入本队列，由 GameScene 在伤害阶段统一结算一次：
+// - 按排入顺序逐条调用目标的 takeDamage，护甲、减伤、Cup 分担、受击无敌、死亡仍由各自的覆写处理
+// - 实际生效值（HP 差值）只在这里计算
+// - 浮字按目标合并：每个目标每次结算只显示一个合计数字
+// 结算中新产生的伤害（例如死亡自爆）追加到队尾，在同一次结算中处理。
+// 结算时目标已不在模拟中（离开场景或所属场景已挂起）的伤害直接丢弃。
+class DamageQueue {
+public:
+    static DamageQueue* getInstance();
+    static void destroyInstance();
+
+    // 排入一次伤害，目标在结算前被持有
+    // textColor 为浮字颜色（同一目标以第一条为准），showText 为 false 时该条不显示浮字
+    void push(GameEntity* target, int amount, const cocos2d::Color3B& textColor, bool showText = true);
+
+    // 结算全部排队的伤害（每帧由 GameScene 在伤害阶段调用一次），返回结算的事件数
+    int resolve();
+
+    // 丢弃尚未结算的伤害（离开场景时）
+    void clear();
+
+    int getPendingCount() const { return static_cast<int>(_events.size()); }
+
+private:
+    DamageQueue();
+    ~DamageQueue();
+
+    struct DamageEvent {
+        GameEntity* target;
+        int amount;
+        cocos2d::Color3B textColor;
+        bool showText;
+    };
+
+    // 按目标合并的浮字
+    struct HitText {
+        cocos2d::Node* parent;       // 首次命中时目标的父节点（持有）
+        cocos2d::Vec2 position;      // 首次命中时目标的位置
+        cocos2d::Color3B color;
+        int applied;
+        bool show;
+    };
+
+    static DamageQueue* _instance;
+
+    std::vector<DamageEvent> _events;
+    std::vector<HitText> _texts;                          // 每次结算复用
+    std::unordered_map<GameEntity*, int> _textIndex;      // 目标 -> _texts 下标，每次结算复用
+    bool _resolving;
+};
+
+#endif // __DAMAGE_QUEUE_H__
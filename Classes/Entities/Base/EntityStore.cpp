@@ -0,0 +1,405 @@
+﻿#include "EntityStore.h"
+#include "GameEntity.h"
+#include <algorithm>
+#include <cmath>
+
+EntityStore* EntityStore::_instance = nullptr;
+
+EntityStore* EntityStore::getInstance()
+{
+    if (!_instance)
+    {
+        _instance = new EntityStore();
+    }
+    return _instance;
+}
+
+void EntityStore::destroyInstance()
+{
+    delete _instance;
+    _instance = nullptr;
+}
+
+EntityStore::EntityStore()
+    : _slotEnd(0)
+    , _liveCount(0)
+{
+}
+
+EntityStore::~EntityStore()
+{
+    for (auto chunk : _chunks)
+    {
+        delete chunk;
+    }
+    _chunks.clear();
+}
+
+int EntityStore::allocate(GameEntity* view)
+{
+    int slot;
+    if (!_freeSlots.empty())
+    {
+        // 优先复用最小的空闲槽位，让活跃数据尽量集中在数组前部
+        auto it = std::min_element(_freeSlots.begin(), _freeSlots.end());
+        slot = *it;
+        *it = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    else
+    {
+        slot = _slotEnd++;
+        if (slot / CHUNK_SIZE >= static_cast<int>(_chunks.size()))
+        {
+            _chunks.push_back(new Chunk());
+        }
+    }
+
+    Chunk* chunk = chunkOf(slot);
+    int i = slot % CHUNK_SIZE;
+    chunk->views[i] = view;
+    chunk->active[i] = false;
+    chunk->ticking[i] = false;
+    resetComponents(slot);
+
+    _liveCount++;
+    return slot;
+}
+
+void EntityStore::resetComponents(int slot)
+{
+    Chunk* chunk = chunkOf(slot);
+    int i = slot % CHUNK_SIZE;
+    chunk->transforms[i] = Transform{ 0.0f, 0.0f };
+    chunk->health[i] = Health{ 0, 0, false, 0.0f };
+    chunk->cooldowns[i] = Cooldown{ 0.0f };
+    chunk->status[i] = Status{};
+    chunk->blackboards[i] = Blackboard{ 0.0f, false, 0.0f, 0.0f };
+}
+
+void EntityStore::release(int slot)
+{
+    if (slot < 0 || slot >= _slotEnd) return;
+
+    Chunk* chunk = chunkOf(slot);
+    int i = slot % CHUNK_SIZE;
+    chunk->views[i] = nullptr;
+    chunk->active[i] = false;
+    chunk->ticking[i] = false;
+    _freeSlots.push_back(slot);
+    _liveCount--;
+
+    // 尾部槽位空闲时收缩遍历范围
+    while (_slotEnd > 0 && !chunkOf(_slotEnd - 1)->views[(_slotEnd - 1) % CHUNK_SIZE])
+    {
+        _slotEnd--;
+        _freeSlots.erase(std::find(_freeSlots.begin(), _freeSlots.end(), _slotEnd));
+    }
+}
+
+void EntityStore::setActive(int slot, bool active)
+{
+    chunkOf(slot)->active[slot % CHUNK_SIZE] = active;
+}
+
+void EntityStore::setTicking(int slot, bool ticking)
+{
+    chunkOf(slot)->ticking[slot % CHUNK_SIZE] = ticking;
+}
+
+void EntityStore::syncTransforms()
+{
+    for (int base = 0; base < _slotEnd; base += CHUNK_SIZE)
+    {
+        Chunk* chunk = _chunks[base / CHUNK_SIZE];
+        int count = chunkCount(base);
+        for (int i = 0; i < count; i++)
+        {
+            if (!chunk->active[i]) continue;
+            const cocos2d::Vec2& pos = chunk->views[i]->getPosition();
+            chunk->transforms[i].x = pos.x;
+            chunk->transforms[i].y = pos.y;
+        }
+    }
+}
+
+void EntityStore::updateBlackboards(float targetX, float targetY)
+{
+    for (int base = 0; base < _slotEnd; base += CHUNK_SIZE)
+    {
+        Chunk* chunk = _chunks[base / CHUNK_SIZE];
+        int count = chunkCount(base);
+        for (int i = 0; i < count; i++)
+        {
+            float dx = chunk->transforms[i].x - targetX;
+            float dy = chunk->transforms[i].y - targetY;
+            chunk->blackboards[i].targetDistSq = dx * dx + dy * dy;
+        }
+    }
+}
+
+void EntityStore::tickTimers(float dt)
+{
+    for (int base = 0; base < _slotEnd; base += CHUNK_SIZE)
+    {
+        Chunk* chunk = _chunks[base / CHUNK_SIZE];
+        int count = chunkCount(base);
+        for (int i = 0; i < count; i++)
+        {
+            if (!chunk->active[i] || !chunk->health[i].alive) continue;
+
+            Health& health = chunk->health[i];
+            if (health.hitInvulTimer > 0.0f)
+            {
+                health.hitInvulTimer = std::max(0.0f, health.hitInvulTimer - dt);
+            }
+
+            Cooldown& cooldown = chunk->cooldowns[i];
+            if (cooldown.attackTimer > 0.0f)
+            {
+                cooldown.attackTimer -= dt;
+            }
+        }
+    }
+}
+
+void EntityStore::tickStatus(float dt, std::vector<StatusEvent>& events)
+{
+    for (int base = 0; base < _slotEnd; base += CHUNK_SIZE)
+    {
+        Chunk* chunk = _chunks[base / CHUNK_SIZE];
+        int count = chunkCount(base);
+        for (int i = 0; i < count; i++)
+        {
+            Status& status = chunk->status[i];
+            if (status.count == 0) continue;
+            if (!chunk->active[i] || !chunk->health[i].alive) continue;
+
+            StatusEvent event{ chunk->views[i], 0, StatusEffectType::NONE, false };
+            int topDamage = 0;
+
+            for (int e = 0; e < status.count; )
+            {
+                StatusEffect& effect = status.effects[e];
+                const StatusEffectDef& def = StatusEffects::def(effect.type);
+
+                if (def.tickInterval > 0.0f)
+                {
+                    int damage = 0;
+                    effect.tickAcc += dt;
+                    while (effect.tickAcc >= def.tickInterval)
+                    {
+                        effect.tickAcc -= def.tickInterval;
+                        float dmg = static_cast<float>(effect.magnitude) * def.tickRatio * static_cast<float>(effect.stacks);
+                        damage += static_cast<int>(std::round(dmg));
+                    }
+                    event.damage += damage;
+                    if (damage > topDamage)
+                    {
+                        topDamage = damage;
+                        event.damageType = effect.type;
+                    }
+                }
+
+                if (def.duration > 0.0f)
+                {
+                    effect.remaining -= dt;
+                    if (effect.remaining <= 0.0f)
+                    {
+                        if (def.stacking == StatusStacking::PER_SOURCE)
+                        {
+                            removeSources(status, effect.type);
+                        }
+                        // 保持剩余效果的先后顺序
+                        std::copy(status.effects + e + 1, status.effects + status.count, status.effects + e);
+                        status.count--;
+                        event.expired = true;
+                        continue;
+                    }
+                }
+                e++;
+            }
+
+            if (event.expired || event.damage > 0)
+            {
+                events.push_back(event);
+            }
+        }
+    }
+}
+
+bool EntityStore::applyStatus(int slot, StatusEffectType type, const void* source, int magnitude)
+{
+    Status& status = chunkOf(slot)->status[slot % CHUNK_SIZE];
+    const StatusEffectDef& def = StatusEffects::def(type);
+
+    if (def.stacking == StatusStacking::PER_SOURCE)
+    {
+        // 同一来源重复施加忽略；来源已满时只拒绝新来源，不影响其它效果
+        for (int s = 0; s < status.sourceCount; s++)
+        {
+            if (status.sources[s].type == type && status.sources[s].source == source)
+            {
+                return true;
+            }
+        }
+        if (status.sourceCount >= MAX_STATUS_SOURCES)
+        {
+            return false;
+        }
+        status.sources[status.sourceCount++] = StatusSource{ type, source };
+    }
+
+    for (int e = 0; e < status.count; e++)
+    {
+        StatusEffect& effect = status.effects[e];
+        if (effect.type != type) continue;
+
+        if (def.stacking == StatusStacking::REFRESH)
+        {
+            effect.stacks = std::min(def.maxStacks, effect.stacks + 1);
+            effect.magnitude = magnitude;
+            effect.remaining = def.duration;
+            effect.tickAcc = 0.0f;
+        }
+        else
+        {
+            effect.stacks++;
+        }
+        return true;
+    }
+
+    // 每种效果一个槽位，新效果总有空位
+    status.effects[status.count++] = StatusEffect{ type, 1, magnitude, def.duration, 0.0f };
+    return true;
+}
+
+bool EntityStore::removeStatus(int slot, StatusEffectType type, const void* source)
+{
+    Status& status = chunkOf(slot)->status[slot % CHUNK_SIZE];
+    bool perSource = StatusEffects::def(type).stacking == StatusStacking::PER_SOURCE;
+
+    if (perSource)
+    {
+        int s = 0;
+        while (s < status.sourceCount && (status.sources[s].type != type || status.sources[s].source != source))
+        {
+            s++;
+        }
+        if (s == status.sourceCount)
+        {
+            return false;
+        }
+        status.sources[s] = status.sources[--status.sourceCount];
+    }
+
+    for (int e = 0; e < status.count; e++)
+    {
+        StatusEffect& effect = status.effects[e];
+        if (effect.type != type) continue;
+
+        // 仍有其它来源时效果继续
+        if (perSource && --effect.stacks > 0)
+        {
+            return true;
+        }
+        std::copy(status.effects + e + 1, status.effects + status.count, status.effects + e);
+        status.count--;
+        return true;
+    }
+    return false;
+}
+
+void EntityStore::removeSources(Status& status, StatusEffectType type)
+{
+    for (int s = 0; s < status.sourceCount; )
+    {
+        if (status.sources[s].type == type)
+        {
+            status.sources[s] = status.sources[--status.sourceCount];
+        }
+        else
+        {
+            s++;
+        }
+    }
+}
+
+int EntityStore::getStatusStacks(int slot, StatusEffectType type) const
+{
+    const Status& status = this->status(slot);
+    int stacks = 0;
+    for (int e = 0; e < status.count; e++)
+    {
+        if (status.effects[e].type == type)
+        {
+            stacks += status.effects[e].stacks;
+        }
+    }
+    return stacks;
+}
+
+StatusTint EntityStore::computeStatusTint(int slot) const
+{
+    const Status& status = this->status(slot);
+    unsigned int r = 255, g = 255, b = 255;
+    for (int e = 0; e < status.count; e++)
+    {
+        // 每种效果只占一个槽位，多个隐身来源也只着色一次
+        const StatusTint& tint = StatusEffects::def(status.effects[e].type).tint;
+        r = r * tint.r / 255;
+        g = g * tint.g / 255;
+        b = b * tint.b / 255;
+    }
+    return StatusTint{ static_cast<unsigned char>(r), static_cast<unsigned char>(g), static_cast<unsigned char>(b) };
+}
+
+void EntityStore::collectActive(std::vector<GameEntity*>& out) const
+{
+    for (int base = 0; base < _slotEnd; base += CHUNK_SIZE)
+    {
+        const Chunk* chunk = _chunks[base / CHUNK_SIZE];
+        int count = chunkCount(base);
+        for (int i = 0; i < count; i++)
+        {
+            if (chunk->active[i])
+            {
+                out.push_back(chunk->views[i]);
+            }
+        }
+    }
+}
+
+void EntityStore::collectTicking(std::vector<GameEntity*>& out) const
+{
+    for (int base = 0; base < _slotEnd; base += CHUNK_SIZE)
+    {
+        const Chunk* chunk = _chunks[base / CHUNK_SIZE];
+        int count = chunkCount(base);
+        for (int i = 0; i < count; i++)
+        {
+            if (chunk->active[i] && chunk->ticking[i])
+            {
+                out.push_back(chunk->views[i]);
+            }
+        }
+    }
+}
+
+void EntityStore::collectDeaths(std::vector<GameEntity*>& out)
+{
+    for (int base = 0; base < _slotEnd; base += CHUNK_SIZE)
+    {
+        Chunk* chunk = _chunks[base / CHUNK_SIZE];
+        int count = chunkCount(base);
+        for (int i = 0; i < count; i++)
+        {
+            Health& health = chunk->health[i];
+            if (!health.alive || health.hp > 0) continue;
+            if (!chunk->active[i] || !chunk->ticking[i]) continue;
+
+            health.alive = false;
+            out.push_back(chunk->views[i]);
+        }
+    }
+}
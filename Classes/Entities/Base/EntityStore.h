@@ -0,0 +1,161 @@
+﻿#ifndef __ENTITY_STORE_H__
+#define __ENTITY_STORE_H__
+
+#include <vector>
+#include "StatusEffects.h"
+
+class GameEntity;
+
+// 实体组件存储（数据导向）
+// 把模拟状态（位置快照、生命、冷却、状态效果、AI 黑板）从 Node 子类里拆出来，
+// 按组件类型分别存放在连续数组中，系统函数线性遍历这些数组。
+// GameEntity 只持有槽位号，其成员字段是对槽位数据的引用，原有读写代码不变。
+// 数组按块（CHUNK_SIZE 个槽位）分配，块一旦分配不再移动，保证引用长期有效。
+// 除 syncTransforms 读取节点坐标外，其余系统只访问数组，不依赖 cocos2d。
+class EntityStore {
+public:
+    static const int CHUNK_SIZE = 256;
+
+    // 位置快照（每帧从节点同步一次，供系统批量读取）
+    struct Transform {
+        float x;
+        float y;
+    };
+
+    // 生命
+    struct Health {
+        int hp;
+        int maxHp;
+        bool alive;
+        float hitInvulTimer;     // 受击无敌剩余时间
+    };
+
+    // 冷却
+    struct Cooldown {
+        float attackTimer;       // 攻击冷却剩余时间
+    };
+
+    // 单个状态效果（规则见 StatusEffects::TABLE），每种效果至多占一个槽位
+    struct StatusEffect {
+        StatusEffectType type;
+        int stacks;              // 层数（PER_SOURCE 效果为来源数）
+        int magnitude;           // 强度（毒：来源攻击力）
+        float remaining;         // 剩余时间
+        float tickAcc;           // 跳伤累计
+    };
+
+    // PER_SOURCE 效果的一个来源（用于去重与移除）
+    struct StatusSource {
+        StatusEffectType type;
+        const void* source;
+    };
+
+    // 状态效果（每个实体一段定长数组，有效效果紧凑存放在前 count 个）
+    // 每种效果一个槽位，多个来源共用所属效果的槽位，来源另存，来源再多也不会挤掉其它效果
+    static const int MAX_STATUS_EFFECTS = static_cast<int>(StatusEffectType::COUNT) - 1;
+    static const int MAX_STATUS_SOURCES = 8;
+    struct Status {
+        StatusEffect effects[MAX_STATUS_EFFECTS];
+        int count;
+        StatusSource sources[MAX_STATUS_SOURCES];
+        int sourceCount;
+    };
+
+    // AI 黑板
+    struct Blackboard {
+        float patrolTimer;       // 巡逻计时
+        bool hasTarget;          // 是否锁定目标
+        float targetDistSq;      // 到目标（玩家）距离平方，每帧更新
+        float aiPendingDt;       // AI 降频时累积、尚未执行的时间
+    };
+
+    // 状态系统产出的事件，由场景回放到对应节点上（扣血浮字、刷新着色）
+    // 每个实体每帧至多一条：本帧所有效果的跳伤合并为一次伤害
+    struct StatusEvent {
+        GameEntity* view;
+        int damage;                   // 本帧跳伤合计
+        StatusEffectType damageType;  // 贡献伤害最多的效果（决定浮字颜色）
+        bool expired;                 // 本帧有效果结束（需要刷新着色）
+    };
+
+    static EntityStore* getInstance();
+    static void destroyInstance();
+
+    // 分配/归还槽位（GameEntity 构造/析构时调用），分配时组件数据清零
+    int allocate(GameEntity* view);
+    void release(int slot);
+    // 组件数据恢复为刚分配时的状态（保留视图与 active/ticking 标记，供回收复用的实体使用）
+    void resetComponents(int slot);
+
+    // 是否参与模拟（节点进入/离开场景时切换）
+    void setActive(int slot, bool active);
+    bool isActive(int slot) const { return chunkOf(slot)->active[slot % CHUNK_SIZE]; }
+
+    // 是否参与场景的逐帧实体更新（替代 scheduleUpdate/unscheduleUpdate）
+    void setTicking(int slot, bool ticking);
+    bool isTicking(int slot) const { return chunkOf(slot)->ticking[slot % CHUNK_SIZE]; }
+
+    GameEntity* getView(int slot) const { return chunkOf(slot)->views[slot % CHUNK_SIZE]; }
+    Transform& transform(int slot) { return chunkOf(slot)->transforms[slot % CHUNK_SIZE]; }
+    Health& health(int slot) { return chunkOf(slot)->health[slot % CHUNK_SIZE]; }
+    Cooldown& cooldown(int slot) { return chunkOf(slot)->cooldowns[slot % CHUNK_SIZE]; }
+    const Status& status(int slot) const { return chunkOf(slot)->status[slot % CHUNK_SIZE]; }
+    Blackboard& blackboard(int slot) { return chunkOf(slot)->blackboards[slot % CHUNK_SIZE]; }
+
+    // 系统（每帧由 GameScene 调用一次）
+    // 从节点读取位置到 Transform 数组
+    void syncTransforms();
+    // 以 (targetX, targetY) 为目标刷新黑板中的距离
+    void updateBlackboards(float targetX, float targetY);
+    // 推进受击无敌与攻击冷却计时
+    void tickTimers(float dt);
+    // 推进所有状态效果的持续时间与跳伤，把需要表现的结果追加到 events
+    void tickStatus(float dt, std::vector<StatusEvent>& events);
+    // 按槽位顺序收集参与模拟的节点
+    void collectActive(std::vector<GameEntity*>& out) const;
+    // 按槽位顺序收集需要逐帧更新的节点
+    void collectTicking(std::vector<GameEntity*>& out) const;
+    // 收集 HP 已归零但尚未死亡的实体，并标记为死亡（由调用方执行 die）
+    void collectDeaths(std::vector<GameEntity*>& out);
+
+    // 状态效果（按定义表的叠加规则施加/移除），PER_SOURCE 来源已满时 applyStatus 返回 false
+    bool applyStatus(int slot, StatusEffectType type, const void* source, int magnitude);
+    bool removeStatus(int slot, StatusEffectType type, const void* source);
+    // 该种效果的层数（PER_SOURCE 效果为来源数）
+    int getStatusStacks(int slot, StatusEffectType type) const;
+    bool hasStatus(int slot, StatusEffectType type) const { return getStatusStacks(slot, type) > 0; }
+    // 所有生效效果的着色按通道相乘的结果
+    StatusTint computeStatusTint(int slot) const;
+
+    int getLiveCount() const { return _liveCount; }
+
+private:
+    EntityStore();
+    ~EntityStore();
+
+    struct Chunk {
+        Transform transforms[CHUNK_SIZE];
+        Health health[CHUNK_SIZE];
+        Cooldown cooldowns[CHUNK_SIZE];
+        Status status[CHUNK_SIZE];
+        Blackboard blackboards[CHUNK_SIZE];
+        GameEntity* views[CHUNK_SIZE];
+        bool active[CHUNK_SIZE];
+        bool ticking[CHUNK_SIZE];
+    };
+
+    Chunk* chunkOf(int slot) const { return _chunks[slot / CHUNK_SIZE]; }
+    // 从 base 开始的块内有效槽位数
+    int chunkCount(int base) const { return _slotEnd - base < CHUNK_SIZE ? _slotEnd - base : CHUNK_SIZE; }
+    // 移除某种 PER_SOURCE 效果的全部来源（效果到期时）
+    static void removeSources(Status& status, StatusEffectType type);
+
+    static EntityStore* _instance;
+
+    std::vector<Chunk*> _chunks;
+    std::vector<int> _freeSlots;
+    int _slotEnd;       // 已使用过的最大槽位 + 1，系统只遍历到这里
+    int _liveCount;
+};
+
+#endif // __ENTITY_STORE_H__
@@ -1,17 +1,30 @@
 ﻿#include "GameEntity.h"
+#include "EntityStore.h"
+#include "Utils/LeakTracker.h"
 
 GameEntity::GameEntity()
     : _sprite(nullptr)
-    , _hp(100)
-    , _maxHP(100)
-    , _isAlive(true)
-    , _hitInvulTimer(0.0f)
+    , _baseColor(Color3B::WHITE)
+    , _hitFlashFrame(0)
+    , _storeSlot(EntityStore::getInstance()->allocate(this))
+    , _hp(EntityStore::getInstance()->health(_storeSlot).hp)
+    , _maxHP(EntityStore::getInstance()->health(_storeSlot).maxHp)
+    , _isAlive(EntityStore::getInstance()->health(_storeSlot).alive)
+    , _hitInvulTimer(EntityStore::getInstance()->health(_storeSlot).hitInvulTimer)
 {
+    _hp = 100;
+    _maxHP = 100;
+    _isAlive = true;
+    _hitInvulTimer = 0.0f;
+    
+    LEAK_TRACK_CREATE(this);
 }
 
 GameEntity::~GameEntity()
 {
     // Sprite会被Node自动管理，不需要手动释放
+    EntityStore::getInstance()->release(_storeSlot);
+    LEAK_TRACK_DESTROY(this);
 }
 
 bool GameEntity::init()
@@ -21,29 +34,28 @@ bool GameEntity::init()
         return false;
     }
     
-    // 开启update
-    scheduleUpdate();
+    // 开启逐帧更新（由 GameScene 统一驱动）
+    setUpdateEnabled(true);
     
     return true;
 }
 
-void GameEntity::update(float dt)
+void GameEntity::setUpdateEnabled(bool enabled)
 {
-    Node::update(dt);
+    EntityStore::getInstance()->setTicking(_storeSlot, enabled);
+}
 
-    // 更新受击无敌计时器
-    if (_hitInvulTimer > 0.0f)
-    {
-        _hitInvulTimer -= dt;
-        if (_hitInvulTimer < 0.0f) _hitInvulTimer = 0.0f;
-    }
-    
-    // 检查死亡
-    if (_hp <= 0 && _isAlive)
-    {
-        _isAlive = false;
-        die();
-    }
+void GameEntity::onEnter()
+{
+    Node::onEnter();
+    EntityStore::getInstance()->setActive(_storeSlot, true);
+}
+
+void GameEntity::onExit()
+{
+    EntityStore::getInstance()->setActive(_storeSlot, false);
+    cancelAllTimers();
+    Node::onExit();
 }
 
 void GameEntity::bindSprite(Sprite* sprite, int zOrder)
@@ -56,8 +68,56 @@ void GameEntity::bindSprite(Sprite* sprite, int zOrder)
     _sprite = sprite;
     if (_sprite != nullptr)
     {
+        _baseColor = _sprite->getColor();
+        _sprite->setColor(getDisplayColor());
         this->addChild(_sprite, zOrder);
-        _sprite->setGlobalZOrder(static_cast<float>(zOrder));
+    }
+}
+
+bool GameEntity::applyStatus(StatusEffectType type, const void* source, int magnitude)
+{
+    if (!EntityStore::getInstance()->applyStatus(_storeSlot, type, source, magnitude))
+    {
+        GAME_LOG_ERROR("GameEntity::applyStatus: no free status source for %s", StatusEffects::def(type).name);
+        return false;
+    }
+    refreshTint();
+    return true;
+}
+
+bool GameEntity::removeStatus(StatusEffectType type, const void* source)
+{
+    if (!EntityStore::getInstance()->removeStatus(_storeSlot, type, source))
+    {
+        return false;
+    }
+    refreshTint();
+    return true;
+}
+
+int GameEntity::getStatusStacks(StatusEffectType type) const
+{
+    return EntityStore::getInstance()->getStatusStacks(_storeSlot, type);
+}
+
+Color3B GameEntity::getDisplayColor() const
+{
+    StatusTint tint = EntityStore::getInstance()->computeStatusTint(_storeSlot);
+    return Color3B(_baseColor.r * tint.r / 255, _baseColor.g * tint.g / 255, _baseColor.b * tint.b / 255);
+}
+
+void GameEntity::setBaseColor(const Color3B& color)
+{
+    _baseColor = color;
+    refreshTint();
+}
+
+void GameEntity::refreshTint()
+{
+    // 受击闪烁进行中时不打断，闪烁结束时会恢复为 getDisplayColor()
+    if (_sprite && !_sprite->getActionByTag(100))
+    {
+        _sprite->setColor(getDisplayColor());
     }
 }
 
@@ -105,27 +165,37 @@ int GameEntity::takeDamageReported(int damage)
     }
     
     // 受击效果 - 颜色闪烁
-    if (_sprite != nullptr)
+    playHitFlash();
+
+    return applied;
+}
+
+void GameEntity::playHitFlash()
+{
+    // 同一帧内多次受击只闪烁一次
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+    if (_sprite == nullptr || _hitFlashFrame == frame)
     {
-        _sprite->stopActionByTag(100);
-        _sprite->setColor(Color3B::WHITE);  // 立即重置颜色
-        _sprite->setVisible(true);
-        _sprite->setOpacity(255);
-        
-        // 使用CallFunc+setColor瞬时设置颜色，避免TintTo渐变导致卡顿
-        auto setRed = CallFunc::create([this]() { _sprite->setColor(Color3B(255, 100, 100)); });
-        auto setWhite = CallFunc::create([this]() { _sprite->setColor(Color3B::WHITE); });
-        auto sequence = Sequence::create(
-            setRed, DelayTime::create(0.05f),
-            setWhite, DelayTime::create(0.05f),
-            setRed->clone(), DelayTime::create(0.05f),
-            setWhite->clone(),
-            nullptr);
-        sequence->setTag(100);
-        _sprite->runAction(sequence);
+        return;
     }
+    _hitFlashFrame = frame;
 
-    return applied;
+    _sprite->stopActionByTag(100);
+    _sprite->setColor(getDisplayColor());  // 立即重置颜色
+    _sprite->setVisible(true);
+    _sprite->setOpacity(255);
+    
+    // 使用CallFunc+setColor瞬时设置颜色，避免TintTo渐变导致卡顿
+    auto setRed = CallFunc::create([this]() { _sprite->setColor(Color3B(255, 100, 100)); });
+    auto setWhite = CallFunc::create([this]() { _sprite->setColor(getDisplayColor()); });
+    auto sequence = Sequence::create(
+        setRed, DelayTime::create(0.05f),
+        setWhite, DelayTime::create(0.05f),
+        setRed->clone(), DelayTime::create(0.05f),
+        setWhite->clone(),
+        nullptr);
+    sequence->setTag(100);
+    _sprite->runAction(sequence);
 }
 
 void GameEntity::heal(int healAmount)
@@ -165,9 +235,10 @@ bool GameEntity::checkCollision(GameEntity* other) const
 
 void GameEntity::showDeathEffect()
 {
-    // 停止所有动作和更新
+    // 停止所有动作、延迟回调和更新
     this->stopAllActions();
-    this->unscheduleUpdate();
+    cancelAllTimers();
+    setUpdateEnabled(false);
     
     if (_sprite != nullptr)
     {
@@ -4,6 +4,8 @@
 #include "cocos2d.h"
 #include "Core/Constants.h"
 #include "Core/GameMacros.h"
+#include "Utils/TimerWheel.h"
+#include "Entities/Base/StatusEffects.h"
 
 USING_NS_CC;
 
@@ -14,7 +16,8 @@ public:
     virtual ~GameEntity();
     
     virtual bool init() override;
-    virtual void update(float dt) override;
+    virtual void onEnter() override;
+    virtual void onExit() override;
     
     // 精灵管理
     // 绑定显示精灵
@@ -42,8 +45,12 @@ public:
     // 扣血并返回"实际对该实体造成的 HP 减少值"
     // 用于需要显示"实际生效伤害"的调用点（例如浮动文字）
     // 默认实现包含原有的扣血/闪烁/死亡逻辑并返回实际减少量
+    // 玩法伤害请排入 DamageQueue，由场景在伤害阶段统一调用 takeDamage
     virtual int takeDamageReported(int damage);
     
+    // 受击闪烁（同一帧内多次受击只播放一次）
+    void playHitFlash();
+    
     // 治疗
     virtual void heal(int heal);
     
@@ -64,17 +71,59 @@ public:
     // 显示死亡效果
     virtual void showDeathEffect();
     
+    // 状态效果（数据存放在 EntityStore，施加/移除后自动刷新着色）
+    // source 为来源标识：PER_SOURCE 效果（隐身）按来源去重与移除，REFRESH 效果（毒）忽略
+    bool applyStatus(StatusEffectType type, const void* source, int magnitude = 0);
+    bool removeStatus(StatusEffectType type, const void* source);
+    int getStatusStacks(StatusEffectType type) const;
+    bool hasStatus(StatusEffectType type) const { return getStatusStacks(type) > 0; }
+    
+    // 状态系统回调（EntityStore::tickStatus 产出的事件由场景回放到节点上）
+    // 本帧状态跳伤合计（每实体每帧一次）
+    virtual void onStatusDamage(int damage, StatusEffectType type) {}
+    // 有效果结束，默认刷新着色
+    virtual void onStatusExpired() { refreshTint(); }
+    
+    // 着色：基础色（绑定精灵时的颜色）与所有状态效果着色相乘，受击闪烁结束后也恢复为该值
+    cocos2d::Color3B getDisplayColor() const;
+    void setBaseColor(const cocos2d::Color3B& color);
+    void refreshTint();
+    
+    // 在 EntityStore 中的槽位
+    int getStoreSlot() const { return _storeSlot; }
+    
+    // 是否参与 GameScene 的逐帧实体更新（替代 scheduleUpdate/unscheduleUpdate）
+    // update(dt) 由 GameScene 在移动阶段按槽位顺序调用，HP 归零的死亡判定在伤害阶段统一执行
+    void setUpdateEnabled(bool enabled);
+    
+    // 玩法延迟回调（TimerWheel，随游戏暂停；实体离开场景或 cancelAllTimers 时取消）
+    // 替代 runAction(Sequence(DelayTime, CallFunc))，返回的句柄可用于单独取消
+    template <typename F>
+    TimerWheel::Handle scheduleTimer(float delay, F fn)
+    {
+        return TimerWheel::getInstance()->schedule(delay, &_timerOwner, std::move(fn));
+    }
+    void cancelTimer(TimerWheel::Handle& handle) { TimerWheel::getInstance()->cancel(handle); }
+    void cancelAllTimers() { TimerWheel::getInstance()->cancelAll(_timerOwner); }
+    
 protected:
     Sprite* _sprite;              // 显示精灵
+    cocos2d::Color3B _baseColor;  // 精灵基础色（不含状态着色）
+    unsigned int _hitFlashFrame;  // 上次受击闪烁的帧号
     
-    int _hp;                      // 当前生命值
-    int _maxHP;                   // 最大生命值
+    int _storeSlot;               // EntityStore 槽位（必须先于下面的引用成员声明）
     
-    bool _isAlive;                // 是否存活
+    // 以下字段引用 EntityStore 中的组件数据
+    int& _hp;                     // 当前生命值
+    int& _maxHP;                  // 最大生命值
+    
+    bool& _isAlive;               // 是否存活
 
-    // 受击无敌计时器
-    float _hitInvulTimer;
+    // 受击无敌计时器（由 EntityStore::tickTimers 统一递减）
+    float& _hitInvulTimer;
     static constexpr float HIT_INVUL_DURATION = 0.1f;
+    
+    TimerWheel::Owner _timerOwner;  // 本实体的延迟回调
 };
 
 #endif // __GAME_ENTITY_H__
@@ -0,0 +1,52 @@
+﻿#ifndef __STATUS_EFFECTS_H__
+#define __STATUS_EFFECTS_H__
+
+#include <cstddef>
+
+// 状态效果种类
+enum class StatusEffectType : unsigned char {
+    NONE = 0,   // 空槽位
+    POISON,     // Nymph 剧毒
+    STEALTH,    // 隐身（唐皇烟雾、Boss 阶段、尼卢火）
+    COUNT
+};
+
+// 叠加规则
+enum class StatusStacking : unsigned char {
+    REFRESH,      // 同种效果只占一个槽位：再次施加叠一层、刷新持续时间，强度取最近一次来源
+    PER_SOURCE,   // 按来源计数：所有来源共用一个槽位，同一来源重复施加忽略，所有来源移除后效果结束
+};
+
+// 着色（与实体基础色按通道相乘，多个效果同时存在时依次相乘）
+struct StatusTint {
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+};
+
+// 状态效果定义
+struct StatusEffectDef {
+    const char* name;
+    StatusStacking stacking;
+    int maxStacks;
+    float duration;        // 持续时间（秒），0 表示不自动结束，由来源显式移除
+    float tickInterval;    // 跳伤间隔（秒），0 表示不跳伤
+    float tickRatio;       // 每层每跳造成 magnitude（来源攻击力）的比例
+    StatusTint tint;
+};
+
+namespace StatusEffects {
+    // 定义表，按 StatusEffectType 顺序排列
+    constexpr StatusEffectDef TABLE[] = {
+        // name       stacking                     max   dur    tick  ratio  tint
+        { "None",    StatusStacking::REFRESH,    0,    0.0f,  0.0f, 0.0f,  { 255, 255, 255 } },
+        { "Poison",  StatusStacking::REFRESH,    100,  10.0f, 0.5f, 0.1f,  { 180, 100, 200 } },
+        { "Stealth", StatusStacking::PER_SOURCE, 1,    0.0f,  0.0f, 0.0f,  { 180, 180, 180 } },
+    };
+    static_assert(sizeof(TABLE) / sizeof(TABLE[0]) == static_cast<size_t>(StatusEffectType::COUNT),
+                  "StatusEffects::TABLE must have one row per StatusEffectType");
+
+    constexpr const StatusEffectDef& def(StatusEffectType type) { return TABLE[static_cast<int>(type)]; }
+}
+
+#endif // __STATUS_EFFECTS_H__
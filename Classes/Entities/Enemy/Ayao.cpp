@@ -5,7 +5,8 @@ static const int AYAO_HIT_ACTION_TAG  = 0xA002; // 命中/伤害播放动作 tag
 static const int AYAO_WINDUP_ACTION_TAG = 0xA003; // 攻击前摇动作 tag
 
 Ayao::Ayao()
-    : _moveAnimation(nullptr)
+    : Enemy(EnemyKind::AYAO)
+    , _moveAnimation(nullptr)
     , _attackAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _roomBounds(Rect::ZERO)
@@ -27,9 +28,6 @@ bool Ayao::init()
         return false;
     }
     
-    // 设置敌人类型
-    setEnemyType(EnemyType::MELEE);
-    
     // 设置属性
     setupAyaoAttributes();
     
@@ -64,10 +62,7 @@ void Ayao::update(float dt)
 void Ayao::setupAyaoAttributes()
 {
     // 阿咬基础属性
-    setMaxHP(1000);
-    setHP(1000);
     setAttack(100);
-    setMoveSpeed(100.0f);
     
     // AI参数
     setSightRange(250.0f);      // 视野范围
@@ -188,29 +183,23 @@ void Ayao::attack()
 
         // 保证状态同步（结束后回到 IDLE）
         float windup = this->getAttackWindup();
-        auto delay = DelayTime::create(windup);
-        auto callback = CallFunc::create([this]() {
+        scheduleTimer(windup, [this]() {
             if (_currentState == EntityState::ATTACK)
             {
                 setState(EntityState::IDLE);
             }
         });
-        auto seq = Sequence::create(delay, callback, nullptr);
-        this->runAction(seq); // 放在节点上，避免和 sprite 上动画冲突
     }
     else
     {
         // 没有动画时回退
         float windup = this->getAttackWindup();
-        auto delay = DelayTime::create(windup);
-        auto callback = CallFunc::create([this]() {
+        scheduleTimer(windup, [this]() {
             if (_currentState == EntityState::ATTACK)
             {
                 setState(EntityState::IDLE);
             }
         });
-        auto sequence = Sequence::create(delay, callback, nullptr);
-        this->runAction(sequence);
     }
     
     GAME_LOG("Ayao attacks!");
@@ -233,8 +222,9 @@ void Ayao::die()
     setState(EntityState::DIE);
     _isAlive = false;
 
-    // 停止所有动作
+    // 停止所有动作与延迟回调
     this->stopAllActions();
+    cancelAllTimers();
     if (_sprite)
     {
         _sprite->stopAllActions();
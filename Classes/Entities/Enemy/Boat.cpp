@@ -2,11 +2,13 @@
 #include "Entities/Player/Player.h"
 #include "Scenes/GameScene.h"
 #include "UI/FloatingText.h"
+#include "Utils/LeakTracker.h"
 
 USING_NS_CC;
 
 Boat::Boat()
-    : _isMoving(false)
+    : Enemy(EnemyKind::BOAT)
+    , _isMoving(false)
     , _idleTimer(0.0f)
     , _lifeTimer(0.0f)
     , _collisionCount(0)
@@ -25,19 +27,15 @@ Boat::Boat()
 
 Boat::~Boat()
 {
-    if (_animIdle) _animIdle->release();
-    if (_animMove) _animMove->release();
-    if (_animDie) _animDie->release();
+    if (_animIdle) { LEAK_TRACK_RELEASE(_animIdle); _animIdle->release(); }
+    if (_animMove) { LEAK_TRACK_RELEASE(_animMove); _animMove->release(); }
+    if (_animDie) { LEAK_TRACK_RELEASE(_animDie); _animDie->release(); }
 }
 
 bool Boat::init()
 {
     if (!Enemy::init()) return false;
 
-    setEnemyType(EnemyType::MELEE);
-    setMaxHP(600000);
-    setHP(getMaxHP());
-    setMoveSpeed(150.0f);
     setAttack(0);
 
     // 图层设置，在障碍上方
@@ -77,6 +75,7 @@ void Boat::loadAnimations()
         if (frames.empty()) return nullptr;
         auto anim = Animation::createWithSpriteFrames(frames, delay);
         anim->retain();
+        LEAK_TRACK_RETAIN(anim);
         return anim;
     };
 
@@ -300,6 +299,32 @@ void Boat::die()
     }
 }
 
+void Boat::reset()
+{
+    Enemy::reset();
+
+    _isMoving = false;
+    _idleTimer = 0.0f;
+    _lifeTimer = 0.0f;
+    _collisionCount = 0;
+    _absorbedCount = 0;
+    _collisionCooldown = 0.0f;
+    _moveChangeTimer = 0.0f;
+    _roomBounds = Rect::ZERO;
+    _currentMoveDir = Vec2::ZERO;
+    _deathCallback = nullptr;
+    _absorbCallback = nullptr;
+
+    // 与 init 一致：先原地播放 Idle 动画
+    if (_sprite && _animIdle && !_animIdle->getFrames().empty())
+    {
+        _sprite->setSpriteFrame(_animIdle->getFrames().front()->getSpriteFrame());
+        auto repeat = RepeatForever::create(Animate::create(_animIdle));
+        repeat->setTag(BOAT_ACTION_TAG);
+        _sprite->runAction(repeat);
+    }
+}
+
 void Boat::forceDissipate()
 {
     if (_currentState == EntityState::DIE) return;
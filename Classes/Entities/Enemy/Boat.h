@@ -19,9 +19,6 @@ public:
     // 设置房间边界
     virtual void setRoomBounds(const cocos2d::Rect& bounds) override;
 
-    // 托生莲座不计入房间清理计数
-    virtual bool countsForRoomClear() const override { return false; }
-
     // 强制消失（Boss转阶段时调用）
     void forceDissipate();
 
@@ -30,6 +27,7 @@ public:
 
     // 死亡逻辑
     virtual void die() override;
+    virtual void reset() override;
 
     // 设置死亡回调
     void setDeathCallback(const std::function<void()>& callback) { _deathCallback = callback; }
@@ -37,9 +35,6 @@ public:
     // 设置吸收生命上限的回调（通知Boss）
     void setAbsorbCallback(const std::function<void(int)>& callback) { _absorbCallback = callback; }
 
-    // 无法生成恐卡兹
-    virtual bool canSpawnKongKaZiOnDeath() const override { return false; }
-
 protected:
     void loadAnimations();
     void pickNewDirection();
@@ -1,6 +1,7 @@
 ﻿#include "Cup.h"
 #include "UI/FloatingText.h"
 #include "Entities/Player/Player.h"
+#include "Utils/LeakTracker.h"
 #include "cocos2d.h"
 #include <algorithm>
 #include <string>
@@ -9,11 +10,19 @@ USING_NS_CC;
 
 static const int CUP_IDLE_ACTION_TAG = 0xC001;
 static const int CUP_DIE_ACTION_TAG  = 0xC002;
+static const float CUP_AURA_CELL_SIZE = 300.0f;   // 与默认分担半径相同，光环最多覆盖 3x3 个格子
 
 std::vector<Cup*> Cup::_instances;
+std::vector<int> Cup::_auraOrder;
+unsigned int Cup::_auraSeqCounter = 0;
+InfluenceGrid Cup::_auraGrid(CUP_AURA_CELL_SIZE);
+unsigned int Cup::_auraStamp = 0;
+unsigned int Cup::_auraFrame = 0;
+bool Cup::_auraDirty = true;
 
 Cup::Cup()
-    : _idleAnimation(nullptr)
+    : Enemy(EnemyKind::CUP)
+    , _idleAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _sprite(nullptr)
     , _rangeIndicator(nullptr)
@@ -23,19 +32,22 @@ Cup::Cup()
     , _patrolInterval(1.5f)
     , _patrolDirection(Vec2::ZERO)
     , _hasRoomBounds(false)
+    , _auraIndex(-1)
+    , _auraSeq(0)
 {
 }
 
 Cup::~Cup()
 {
-    auto it = std::find(_instances.begin(), _instances.end(), this);
-    if (it != _instances.end()) _instances.erase(it);
+    unregisterAura();
 
     if (_idleAnimation) {
+        LEAK_TRACK_RELEASE(_idleAnimation);
         _idleAnimation->release();
         _idleAnimation = nullptr;
     }
     if (_dieAnimation) {
+        LEAK_TRACK_RELEASE(_dieAnimation);
         _dieAnimation->release();
         _dieAnimation = nullptr;
     }
@@ -48,10 +60,6 @@ bool Cup::init()
         return false;
     }
 
-    setEnemyType(EnemyType::MELEE);
-    setMaxHP(300000);
-    setHP(getMaxHP());
-    setMoveSpeed(80.0f);
 
 
     Sprite* initial = Sprite::create("Enemy/Cup/Cup_Idle/Cup_Idle_0001.png");
@@ -78,20 +86,96 @@ bool Cup::init()
     if (_rangeIndicator) {
         int rangeZ = Constants::ZOrder::ENTITY - 1;
         this->addChild(_rangeIndicator, rangeZ);
-        _rangeIndicator->setGlobalZOrder(static_cast<float>(rangeZ));
     }
 
     _patrolInterval = 1.5f + CCRANDOM_0_1() * 1.5f;
     _patrolTimer = 0.0f;
     _patrolDirection = Vec2::ZERO;
 
-    scheduleUpdate();
+    return true;
+}
+
+void Cup::onEnter()
+{
+    Enemy::onEnter();
 
-    if (std::find(_instances.begin(), _instances.end(), this) == _instances.end()) {
-        _instances.push_back(this);
+    if (!isDead()) {
+        registerAura();
     }
+}
 
-    return true;
+void Cup::onExit()
+{
+    unregisterAura();
+
+    Enemy::onExit();
+}
+
+void Cup::registerAura()
+{
+    if (_auraIndex >= 0) return;
+    _auraIndex = static_cast<int>(_instances.size());
+    _auraSeq = ++_auraSeqCounter;
+    _instances.push_back(this);
+    _auraDirty = true;
+}
+
+void Cup::unregisterAura()
+{
+    if (_auraIndex < 0) return;
+    Cup* last = _instances.back();
+    _instances[_auraIndex] = last;
+    last->_auraIndex = _auraIndex;
+    _instances.pop_back();
+    _auraIndex = -1;
+    _auraDirty = true;
+}
+
+unsigned int Cup::refreshAuraIndex()
+{
+    // Cup 会巡逻移动：每帧首次查询时按当前位置重建；登记变化后立即重建，保证索引中没有已注销的 Cup
+    unsigned int frame = Director::getInstance()->getTotalFrames();
+    if (_auraDirty || _auraFrame != frame)
+    {
+        if (_auraDirty)
+        {
+            // 网格按登记顺序返回覆盖者，因此按登记序号插入，重叠时取最先登记的 Cup
+            _auraOrder.resize(_instances.size());
+            for (int i = 0; i < static_cast<int>(_instances.size()); i++)
+            {
+                _auraOrder[i] = i;
+            }
+            std::sort(_auraOrder.begin(), _auraOrder.end(), [](int a, int b) {
+                return _instances[a]->_auraSeq < _instances[b]->_auraSeq;
+            });
+        }
+
+        _auraGrid.clear();
+        for (int i : _auraOrder)
+        {
+            if (!_instances[i]->canShare()) continue;
+            const Vec2& pos = _instances[i]->getPosition();
+            _auraGrid.insert(i, pos.x, pos.y, _instances[i]->getShareRadius());
+        }
+        _auraFrame = frame;
+        _auraDirty = false;
+        _auraStamp++;
+    }
+    return _auraStamp;
+}
+
+Cup* Cup::findCovering(const Vec2& pos)
+{
+    refreshAuraIndex();
+    int index = _auraGrid.findCovering(pos.x, pos.y);
+    if (index >= 0 && !_instances[index]->canShare())
+    {
+        // 本帧建索引后 HP 才归零：按当前状态重建再查，让重叠的其他 Cup 接手
+        _auraDirty = true;
+        refreshAuraIndex();
+        index = _auraGrid.findCovering(pos.x, pos.y);
+    }
+    return index >= 0 ? _instances[index] : nullptr;
 }
 
 void Cup::loadAnimations()
@@ -109,6 +193,7 @@ void Cup::loadAnimations()
     if (!idleFrames.empty()) {
         _idleAnimation = Animation::createWithSpriteFrames(idleFrames, 0.14f);
         _idleAnimation->retain();
+        LEAK_TRACK_RETAIN(_idleAnimation);
         if (_sprite) {
             SpriteFrame* first = idleFrames.front();
             if (first) _sprite->setSpriteFrame(first);
@@ -128,6 +213,7 @@ void Cup::loadAnimations()
     if (!dieFrames.empty()) {
         _dieAnimation = Animation::createWithSpriteFrames(dieFrames, 0.12f);
         _dieAnimation->retain();
+        LEAK_TRACK_RETAIN(_dieAnimation);
     }
 }
 
@@ -226,10 +312,9 @@ void Cup::die()
     setState(EntityState::DIE);
     _isAlive = false;
 
-    unscheduleUpdate();
+    setUpdateEnabled(false);
 
-    auto it = std::find(_instances.begin(), _instances.end(), this);
-    if (it != _instances.end()) _instances.erase(it);
+    unregisterAura();
 
     if (_dieAnimation && _sprite) {
         auto idleAct = _sprite->getActionByTag(CUP_IDLE_ACTION_TAG);
@@ -2,6 +2,7 @@
 #define __CUP_H__
 
 #include "Enemy.h"
+#include "Utils/InfluenceGrid.h"
 #include "cocos2d.h"
 #include <vector>
 
@@ -13,6 +14,10 @@ public:
     virtual bool init() override;
     CREATE_FUNC(Cup);
 
+    // 进入场景后才参与伤害分担（对象池中预留的实例不在场景里）
+    virtual void onEnter() override;
+    virtual void onExit() override;
+
     // Cup 不进行攻击
     virtual void attack() override {}
 
@@ -26,12 +31,20 @@ public:
     void absorbDamage(int damage);
 
     virtual void die() override;
-    virtual bool canSpawnKongKaZiOnDeath() const override { return false; }
 
     virtual void setRoomBounds(const cocos2d::Rect& bounds) override;
 
     static const std::vector<Cup*>& getInstances();
 
+    // 光环索引：存活 Cup 的分担范围登记在 InfluenceGrid 中，每帧首次查询时按当前位置重建，
+    // Cup 进出场景或死亡时标记重建。返回索引版本号（每次重建递增，可用于缓存查询结果）
+    static unsigned int refreshAuraIndex();
+    // 分担范围覆盖 pos 的 Cup（多个时取最先登记的一个），没有时返回 nullptr
+    static Cup* findCovering(const cocos2d::Vec2& pos);
+
+    // 是否仍能分担伤害：死亡在伤害结算后统一执行，HP 归零到 die() 之间已不能再吸收伤害
+    bool canShare() const { return _isAlive && !isDead(); }
+
     float getShareRadius() const { return _shareRadius; }
     float getShareRatio() const { return _shareRatio; }
 
@@ -54,7 +67,20 @@ protected:
     cocos2d::Rect _roomBounds;
     bool _hasRoomBounds;
 
+    // 登记/注销（_instances 中交换删除，O(1)）
+    void registerAura();
+    void unregisterAura();
+
+    int _auraIndex;          // 在 _instances 中的下标，未登记为 -1
+    unsigned int _auraSeq;   // 登记序号（交换删除会打乱 _instances，重建索引时按序号登记）
+
     static std::vector<Cup*> _instances;
+    static std::vector<int> _auraOrder;   // 按登记序号排列的 _instances 下标，登记变化时重排
+    static unsigned int _auraSeqCounter;
+    static InfluenceGrid _auraGrid;
+    static unsigned int _auraStamp;
+    static unsigned int _auraFrame;
+    static bool _auraDirty;
 };
 
 #endif // __CUP_H__
\ No newline at end of file
@@ -1,7 +1,8 @@
 ﻿#include "DeYi.h"
 #include "Entities/Player/Player.h"
 #include "Scenes/GameScene.h"
-#include "UI/FloatingText.h"
+#include "Entities/Base/DamageQueue.h"
+#include "Utils/VfxShapes.h"
 #include "cocos2d.h"
 
 USING_NS_CC;
@@ -13,7 +14,8 @@ static const int DEYI_EXPLOSION_DAMAGE = 1200; // 爆炸造成的“大量伤害
 static const float DEYI_EXPLOSION_RADIUS = 80.0f; // 爆炸半径（和判定距离）
 
 DeYi::DeYi()
-    : _moveAnimation(nullptr)
+    : Enemy(EnemyKind::DEYI)
+    , _moveAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _roomBounds(Rect::ZERO)
     , _hasRoomBounds(false)
@@ -34,9 +36,6 @@ bool DeYi::init()
         return false;
     }
 
-    // 地面近战单位
-    setEnemyType(EnemyType::MELEE);
-
     setupDeYiAttributes();
     loadAnimations();
 
@@ -64,10 +63,7 @@ void DeYi::setRoomBounds(const cocos2d::Rect& bounds)
 void DeYi::setupDeYiAttributes()
 {
     // 基础属性（根据需要调整）
-    setMaxHP(1000);
-    setHP(1000);
     setAttack(0); // 不使用常规近战攻击
-    setMoveSpeed(140.0f);
 
     // AI 参数
     setSightRange(350.0f);
@@ -185,15 +181,13 @@ void DeYi::doExplosion()
     Vec2 localPos = this->getPosition();
     Node* parent = this->getParent();
 
-    auto circle = DrawNode::create();
-    circle->drawSolidCircle(Vec2::ZERO, DEYI_EXPLOSION_RADIUS, 0, 32, Color4F(1.0f, 0.4f, 0.2f, 0.6f)); // 橙色半透明
-
+    // 橙色半透明圆：停留 0.1 秒后淡出并回收
+    Color4F circleColor(1.0f, 0.4f, 0.2f, 0.6f);
     if (parent)
     {
         int rangeZ = Constants::ZOrder::ENTITY - 1;
-        parent->addChild(circle, rangeZ);
-        circle->setPosition(localPos);
-        circle->setGlobalZOrder(static_cast<float>(rangeZ));
+        VfxShapes::spawnDisc(parent, localPos, DEYI_EXPLOSION_RADIUS, circleColor,
+                             0.1f, 0.5f, rangeZ);
     }
     else
     {
@@ -202,18 +196,11 @@ void DeYi::doExplosion()
         if (running)
         {
             Vec2 worldPos = this->convertToWorldSpace(Vec2::ZERO);
-            running->addChild(circle, Constants::ZOrder::EFFECT);
-            circle->setPosition(worldPos);
+            VfxShapes::spawnDisc(running, worldPos, DEYI_EXPLOSION_RADIUS, circleColor,
+                                 0.1f, 0.5f, Constants::ZOrder::EFFECT);
         }
     }
 
-    // 在圆自身上运行淡出并移除
-    auto fade = FadeOut::create(0.5f);
-    auto removeCircle = CallFunc::create([circle]() {
-        if (circle->getParent()) circle->removeFromParent();
-    });
-    circle->runAction(Sequence::create(DelayTime::create(0.1f), fade, removeCircle, nullptr));
-
     // 对玩家造成伤害（若在半径内）
     Scene* running = Director::getInstance()->getRunningScene();
     GameScene* gs = nullptr;
@@ -238,15 +225,7 @@ void DeYi::doExplosion()
             float dist = player->getPosition().distance(this->getPosition());
             if (dist <= DEYI_EXPLOSION_RADIUS)
             {
-                player->takeDamage(DEYI_EXPLOSION_DAMAGE);
-
-                // 显示伤害浮字（同毒伤表现）
-                Scene* runningScene = Director::getInstance()->getRunningScene();
-                if (runningScene)
-                {
-                    Vec2 worldP = player->convertToWorldSpace(Vec2::ZERO);
-                    FloatingText::show(runningScene, worldP, std::to_string(DEYI_EXPLOSION_DAMAGE), Color3B(255,180,50));
-                }
+                DamageQueue::getInstance()->push(player, DEYI_EXPLOSION_DAMAGE, Color3B(255,180,50));
             }
         }
     }
@@ -276,6 +255,7 @@ void DeYi::die()
     _isAlive = false;
 
     this->stopAllActions();
+    cancelAllTimers();
     if (_sprite)
     {
         _sprite->stopAllActions();
@@ -312,6 +292,21 @@ void DeYi::die()
     }
 }
 
+void DeYi::reset()
+{
+    Enemy::reset();
+
+    _hasExploded = false;
+    _roomBounds = Rect::ZERO;
+    _hasRoomBounds = false;
+
+    // 死亡动画停在最后一帧，恢复为移动动画第一帧
+    if (_sprite && _moveAnimation && !_moveAnimation->getFrames().empty())
+    {
+        _sprite->setSpriteFrame(_moveAnimation->getFrames().front()->getSpriteFrame());
+    }
+}
+
 void DeYi::move(const cocos2d::Vec2& direction, float dt)
 {
     // 行为类似 Ayao：攻击/死亡状态不移动，控制移动动画与朝向
@@ -35,6 +35,7 @@ public:
 
     // 覆写 die：在被击杀时触发爆炸（若尚未爆炸）
     virtual void die() override;
+    virtual void reset() override;
 
     virtual void move(const cocos2d::Vec2& direction, float dt) override;
 
@@ -2,7 +2,7 @@
 #include "cocos2d.h"
 #include "Entities/Player/Player.h"
 #include "Scenes/GameScene.h"
-#include "UI/FloatingText.h"
+#include "Entities/Base/DamageQueue.h"
 #include "Core/Constants.h"
 #include <algorithm>
 
@@ -17,7 +17,8 @@ static constexpr float DU_BULLET_SPEED = 700.0f;
 static const char* DU_BULLET_SCHEDULE_KEY = "DuBulletUpdate";
 
 Du::Du()
-    : _moveAnimation(nullptr)
+    : Enemy(EnemyKind::DU)
+    , _moveAnimation(nullptr)
     , _attackAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _bulletAnimation(nullptr)
@@ -40,8 +41,6 @@ bool Du::init()
 {
     if (!Enemy::init()) return false;
 
-    setEnemyType(EnemyType::RANGED);
-
     setupAttributes();
     loadAnimations();
 
@@ -60,12 +59,8 @@ bool Du::init()
 
 void Du::setupAttributes()
 {
-    // 依据需求：远程，攻击前摇 0.8s，索敌范围大，伤害偏高
-    setMaxHP(3500);
-    setHP(3500);
-
+    // 依据需求：远程，攻击前摇 0.8s，索敌范围大，伤害偏高（血量与移速见 EnemyKinds::TABLE）
     setAttack(1800); // 造成大量伤害（可根据平衡调整）
-    setMoveSpeed(65.0f);
 
     setSightRange(500.0f);   // 远程索敌大范围
     setAttackRange(420.0f);  // 远程攻击范围
@@ -267,9 +262,8 @@ void Du::attack()
 
         float windup = this->getAttackWindup();
         Player* target = _attackTarget;
-        auto delay = DelayTime::create(windup);
         // 在 windup 完成时实际发射子弹（并进入发射等待状态直到子弹结束）
-        auto callback = CallFunc::create([this, target]() {
+        scheduleTimer(windup, [this, target]() {
             if (_currentState == EntityState::ATTACK)
             {
                 // 面向目标并发射
@@ -285,16 +279,13 @@ void Du::attack()
                 }
             }
         });
-        auto seq = Sequence::create(delay, callback, nullptr);
-        this->runAction(seq);
     }
     else
     {
         // 无动画时使用 windup 定时并发射
         float windup = this->getAttackWindup();
         Player* target = _attackTarget;
-        auto delay = DelayTime::create(windup);
-        auto callback = CallFunc::create([this, target]() {
+        scheduleTimer(windup, [this, target]() {
             if (_currentState == EntityState::ATTACK)
             {
                 if (target && !target->isDead())
@@ -308,7 +299,6 @@ void Du::attack()
                 }
             }
         });
-        this->runAction(Sequence::create(delay, callback, nullptr));
     }
 
     GAME_LOG("Du begins attack (windup)!");
@@ -384,12 +374,6 @@ void Du::fireBullet(Player* target)
         bulletNode->setRotation(-angle);
     }
 
-    // 设置层级（与其他投射物一致）
-    if (auto spr = dynamic_cast<Sprite*>(bulletNode))
-    {
-        spr->setGlobalZOrder(Constants::ZOrder::PROJECTILE);
-    }
-
     // 启动每帧检测，处理命中玩家 / 碰撞边界 / 障碍（改为更稳健的世界坐标距离检测，避免穿墙或无法命中）
     bulletNode->schedule([this, bulletNode, targetPos](float dt) {
         // 若 bullet 已移除，中止
@@ -445,8 +429,7 @@ void Du::fireBullet(Player* target)
             {
                 // 命中造成大量伤害（使用 Du 的攻击力）
                 int dmg = this->getAttack();
-                player->takeDamage(dmg);
-                FloatingText::show(bulletNode->getParent(), player->getPosition(), std::to_string(dmg), Color3B(220,20,20));
+                DamageQueue::getInstance()->push(player, dmg, Color3B(220,20,20));
                 GAME_LOG("Du bullet hits player for %d damage!", dmg);
 
                 // 移除子弹並结束发射等待
@@ -603,6 +586,7 @@ void Du::die()
 
     // 停止动作并播放死亡动画
     this->stopAllActions();
+    cancelAllTimers();
     if (_sprite) { _sprite->stopAllActions(); _sprite->setVisible(true); _sprite->setOpacity(255); }
 
     auto finalizeRemove = [this]() {
@@ -628,6 +612,24 @@ void Du::die()
     finalizeRemove();
 }
 
+void Du::reset()
+{
+    Enemy::reset();
+
+    // 未决子弹已在死亡收尾时移除
+    _isFiring = false;
+    _currentBullet = nullptr;
+    _attackTarget = nullptr;
+    _roomBounds = Rect::ZERO;
+    _hasRoomBounds = false;
+
+    // 死亡动画停在最后一帧，恢复为移动动画第一帧
+    if (_sprite && _moveAnimation && !_moveAnimation->getFrames().empty())
+    {
+        _sprite->setSpriteFrame(_moveAnimation->getFrames().front()->getSpriteFrame());
+    }
+}
+
 /**
  * 覆写移动：当处于 ATTACK/发射中或死亡时禁止移动，并控制移动动画播放/停止。
  * 实现风格与 Ayao::move 保持一致，同时考虑 _isFiring（发射期间不移动）。
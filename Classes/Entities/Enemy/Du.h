@@ -20,6 +20,7 @@ public:
     virtual void attack() override;
     virtual void playAttackAnimation() override;
     virtual void die() override;
+    virtual void reset() override;
 
     // 覆写以接收房间边界
     virtual void setRoomBounds(const cocos2d::Rect& bounds) override;
@@ -1,31 +1,33 @@
 ﻿#include "Enemy.h"
+#include "Entities/Base/EntityStore.h"
+#include "Entities/Base/DamageQueue.h"
 #include "Entities/Player/Player.h"
-#include "UI/FloatingText.h"
-#include "Entities/Enemy/KongKaZi.h"
 #include "Entities/Enemy/Cup.h"
 #include "Scenes/GameScene.h"
+#include "Map/Room.h"
+#include "Utils/VfxShapes.h"
+#include "Utils/HitchDetector.h"
 #include "cocos2d.h"
 #include <cmath>
 #include <algorithm>
 
 USING_NS_CC;
 
-Enemy::Enemy()
-    : _enemyType(EnemyType::MELEE)
+Enemy::Enemy(EnemyKind kind)
+    : _kind(kind)
+    , _enemyType(EnemyType::MELEE)
     , _sightRange(Constants::Enemy::CHASE_RANGE)
     , _attackRange(Constants::Enemy::ATTACK_RANGE)
     , _patrolTarget(Vec2::ZERO)
-    , _patrolTimer(0.0f)
+    , _patrolTimer(EntityStore::getInstance()->blackboard(_storeSlot).patrolTimer)
     , _patrolInterval(2.0f)
-    , _hasTarget(false)
+    , _hasTarget(EntityStore::getInstance()->blackboard(_storeSlot).hasTarget)
     , _attackWindup(0.5f)
-    , _poisonStacks(0)
-    , _poisonTimer(0.0f)
-    , _poisonTickAcc(0.0f)
-    , _poisonSourceAttack(0)
-    , _poisonColorSaved(false)
-    , _stealthColorSaved(false)
     , _isRedMarked(false)
+    , _coveringCup(nullptr)
+    , _coveringCupStamp(0)
+    , _clearRoom(nullptr)
+    , _clearHoldRoom(nullptr)
 {
 }
 
@@ -40,9 +42,12 @@ bool Enemy::init()
         return false;
     }
 
-    setHP(Constants::Enemy::MELEE_HP);
-    setMaxHP(Constants::Enemy::MELEE_HP);
-    setMoveSpeed(Constants::Enemy::DEFAULT_MOVE_SPEED);
+    // 基础属性取自特性表，子类可在自己的 init 中继续调整
+    const EnemyTraits& traits = getTraits();
+    setEnemyType(traits.type);
+    setHP(traits.maxHP);
+    setMaxHP(traits.maxHP);
+    setMoveSpeed(traits.moveSpeed);
     setAttack(10);
 
     setTag(Constants::Tag::ENEMY);
@@ -50,163 +55,97 @@ bool Enemy::init()
     return true;
 }
 
-void Enemy::update(float dt)
+void Enemy::setState(EntityState state)
 {
-    Character::update(dt);
+    Character::setState(state);
 
-    // 处理毒伤逻辑（保持原逻辑，但浮字显示改为实际生效伤害）
-    if (_poisonStacks > 0)
+    if (state == EntityState::DIE && _clearRoom)
     {
-        _poisonTimer -= dt;
-        _poisonTickAcc += dt;
-
-        while (_poisonTickAcc >= POISON_TICK_INTERVAL)
-        {
-            _poisonTickAcc -= POISON_TICK_INTERVAL;
-
-            if (_poisonSourceAttack > 0 && _poisonStacks > 0)
-            {
-                float dmgF = static_cast<float>(_poisonSourceAttack) * POISON_TICK_RATIO * static_cast<float>(_poisonStacks);
-                int dmg = static_cast<int>(std::round(dmgF));
-                if (dmg > 0)
-                {
-                    int applied = this->takeDamageReported(dmg);
-                    Scene* running = Director::getInstance()->getRunningScene();
-                    if (running && applied > 0)
-                    {
-                        Vec2 worldPos = this->convertToWorldSpace(Vec2::ZERO);
-                        FloatingText::show(running, worldPos, std::to_string(applied), Color3B(180,100,200));
-                    }
-                    GAME_LOG("Poison tick: %d damage applied to enemy (stacks=%d, srcAtk=%d, shown=%d)", dmg, _poisonStacks, _poisonSourceAttack, applied);
-                }
-            }
-        }
-
-        if (_poisonTimer <= 0.0f)
-        {
-            _poisonStacks = 0;
-            _poisonTimer = 0.0f;
-            _poisonTickAcc = 0.0f;
-            _poisonSourceAttack = 0;
-            // 如果当前处于隐身优先恢复为 stealth 原始色
-            if (_poisonColorSaved && _sprite)
-            {
-                if (!_stealthSources.empty() && _stealthColorSaved)
-                {
-                    // 仍处于隐身，保持隐身色
-                }
-                else
-                {
-                    _sprite->setColor(_poisonOriginalColor);
-                }
-            }
-            _poisonColorSaved = false;
-            GAME_LOG("Poison expired on enemy, stacks cleared");
-        }
+        // notifyEnemyKilled 会清空 _clearRoom，保证只回报一次
+        _clearRoom->notifyEnemyKilled(this);
     }
 }
 
-// Nymph 中毒逻辑实现
-void Enemy::applyNymphPoison(int sourceAttack)
+void Enemy::holdRoomClear()
 {
-    // 如果实体不允许被剧毒影响，则忽略（例如 Boss 在阶段 A）
-    if (!isPoisonable())
-    {
-        GAME_LOG("Enemy::applyNymphPoison ignored because entity is not poisonable");
-        return;
-    }
-
-    // 保存原始颜色（首次中毒时）
-    if (!_poisonColorSaved && _sprite)
-    {
-        _poisonOriginalColor = _sprite->getColor();
-        _poisonColorSaved = true;
-    }
-
-    // 重置毒计时为 10s
-    _poisonTimer = POISON_DURATION;
-    _poisonTickAcc = 0.0f;
-
-    // 更新毒源攻击力为当前来源攻击力（使用最近一次来源的攻击力）
-    _poisonSourceAttack = sourceAttack;
-
-    // 叠加一层，最多 POISON_MAX_STACKS
-    _poisonStacks = std::min(POISON_MAX_STACKS, _poisonStacks + 1);
-
-    // 根据当前是否处于隐身决定颜色：
-    // - 非隐身：紫色（原来行为）
-    // - 隐身中：使用更深的紫灰（以示同时中毒与隐身）
-    if (_sprite)
-    {
-        if (_stealthSources.empty())
-        {
-            Color3B purple(180, 100, 200);
-            _sprite->setColor(purple);
-        }
-        else
-        {
-            // 隐身且中毒：更深的紫灰色（可调整）
-            Color3B deepStealthPoison(120, 80, 150);
-            _sprite->setColor(deepStealthPoison);
-        }
-    }
-
-    GAME_LOG("applyNymphPoison: stacks=%d, srcAtk=%d", _poisonStacks, _poisonSourceAttack);
+    if (_clearHoldRoom || !_clearRoom) return;
+    _clearHoldRoom = _clearRoom;
+    _clearHoldRoom->holdClear();
 }
 
-// Stealth 源管理实现
-void Enemy::addStealthSource(void* source)
+void Enemy::releaseRoomClear()
 {
-    if (!source) return;
-    // 如果已存在相同来源，忽略
-    if (std::find(_stealthSources.begin(), _stealthSources.end(), source) != _stealthSources.end()) return;
+    if (!_clearHoldRoom) return;
+    Room* room = _clearHoldRoom;
+    _clearHoldRoom = nullptr;
+    room->releaseClear();
+}
 
-    // 首次加入时保存当前颜色以便恢复
-    if (_stealthSources.empty() && _sprite)
+void Enemy::reset()
+{
+    stopAllActions();
+    cancelAllTimers();
+    if (_sprite)
     {
-        _stealthOriginalColor = _sprite->getColor();
-        _stealthColorSaved = true;
+        _sprite->stopAllActions();
+        _sprite->setVisible(true);
+        _sprite->setOpacity(255);
     }
 
-    _stealthSources.push_back(source);
-
-    if (_sprite)
+    // 生命、冷却、状态效果与黑板回到新分配槽位的状态，再按特性表填回
+    EntityStore::getInstance()->resetComponents(_storeSlot);
+    const EnemyTraits& traits = getTraits();
+    setHP(traits.maxHP);
+    setMaxHP(traits.maxHP);
+    setMoveSpeed(traits.moveSpeed);
+    _isAlive = true;
+
+    // DIE -> IDLE 不会回报房间（死亡时已回报，_clearRoom 已清空）
+    setState(EntityState::IDLE);
+    _clearRoom = nullptr;
+    _patrolTarget = Vec2::ZERO;
+    _coveringCup = nullptr;
+    _coveringCupStamp = 0;
+
+    // 红色标记改过基础色，回收的种类都以白色精灵帧为基础色
+    if (_isRedMarked)
     {
-        // 隐身时如果同时带毒，显示更深的毒色；否则显示浅灰隐身色
-        if (_poisonStacks > 0)
-        {
-            Color3B deepStealthPoison(120, 80, 150);
-            _sprite->setColor(deepStealthPoison);
-        }
-        else
-        {
-            _sprite->setColor(Color3B(180, 180, 180));
-        }
+        _isRedMarked = false;
+        _baseColor = Color3B::WHITE;
     }
+    refreshTint();
+
+    setUpdateEnabled(true);
 }
 
-void Enemy::removeStealthSource(void* source)
+void Enemy::onExit()
 {
-    if (!source) return;
-    auto it = std::find(_stealthSources.begin(), _stealthSources.end(), source);
-    if (it == _stealthSources.end()) return;
+    releaseRoomClear();
+    Character::onExit();
+}
 
-    _stealthSources.erase(it);
+void Enemy::onStatusDamage(int damage, StatusEffectType type)
+{
+    // 排入伤害队列，浮字颜色取效果着色
+    const StatusTint& tint = StatusEffects::def(type).tint;
+    DamageQueue::getInstance()->push(this, damage, Color3B(tint.r, tint.g, tint.b));
+    GAME_LOG("Status tick: %d %s damage queued on enemy (stacks=%d)", damage, StatusEffects::def(type).name, getStatusStacks(type));
+}
 
-    if (_stealthSources.empty())
+// Nymph 中毒逻辑实现
+void Enemy::applyNymphPoison(int sourceAttack)
+{
+    // 如果实体不允许被剧毒影响，则忽略（例如 Boss 在阶段 A）
+    if (!isPoisonable())
     {
-        // 没有隐身来源了，恢复颜色：若仍有毒则显示毒色，否则恢复之前保存的颜色
-        if (_poisonStacks > 0 && _sprite)
-        {
-            Color3B purple(180, 100, 200);
-            _sprite->setColor(purple);
-        }
-        else if (_stealthColorSaved && _sprite)
-        {
-            _sprite->setColor(_stealthOriginalColor);
-            _stealthColorSaved = false;
-        }
+        GAME_LOG("Enemy::applyNymphPoison ignored because entity is not poisonable");
+        return;
     }
+
+    // 叠加一层并刷新持续时间，毒源攻击力取最近一次来源
+    applyStatus(StatusEffectType::POISON, nullptr, sourceAttack);
+
+    GAME_LOG("applyNymphPoison: stacks=%d, srcAtk=%d", getPoisonStacks(), sourceAttack);
 }
 
 void Enemy::executeAI(Player* player, float dt)
@@ -235,8 +174,7 @@ void Enemy::executeAI(Player* player, float dt)
                 attack();
 
                 // 使用成员 _attackWindup 作为风箱时长，风箱结束时再判断是否命中
-                auto delay = DelayTime::create(this->_attackWindup);
-                auto callback = CallFunc::create([this, player]() {
+                scheduleTimer(this->_attackWindup, [this, player]() {
                     if (player == nullptr || player->isDead() || this->_currentState == EntityState::DIE)
                     {
                         return;
@@ -253,8 +191,6 @@ void Enemy::executeAI(Player* player, float dt)
                         GAME_LOG("Player escaped during attack windup");
                     }
                 });
-                auto seq = Sequence::create(delay, callback, nullptr);
-                this->runAction(seq);
             }
         }
         else
@@ -339,15 +275,12 @@ void Enemy::attack()
     GAME_LOG("Enemy attacks!");
 
     // 攻击动画结束后返回IDLE
-    auto delay = DelayTime::create(this->_attackWindup);
-    auto callback = CallFunc::create([this]() {
+    scheduleTimer(this->_attackWindup, [this]() {
         if (_currentState == EntityState::ATTACK)
         {
             setState(EntityState::IDLE);
         }
     });
-    auto sequence = Sequence::create(delay, callback, nullptr);
-    this->runAction(sequence);
 }
 
 bool Enemy::isPlayerInAttackRange(Player* player) const
@@ -369,7 +302,7 @@ void Enemy::attackPlayer(Player* player)
     }
 
     // 造成伤害
-    player->takeDamage(_attack);
+    DamageQueue::getInstance()->push(player, _attack, Color3B(220, 20, 20));
 
     GAME_LOG("Enemy deals %d damage to player", _attack);
 }
@@ -390,10 +323,7 @@ void Enemy::tryApplyRedMark(float chance)
     if (r <= chance)
     {
         _isRedMarked = true;
-        if (_sprite)
-        {
-            _sprite->setColor(Color3B(255, 80, 80));
-        }
+        setBaseColor(Color3B(255, 80, 80));
         GAME_LOG("Enemy marked RED for KongKaZi spawn (chance succeeded)");
     }
 }
@@ -408,80 +338,63 @@ void Enemy::die()
         Vec2 localPos = this->getPosition();
         Scene* running = Director::getInstance()->getRunningScene();
 
-        auto circle = DrawNode::create();
+        // 紫色圆：停留 0.25 秒后淡出并回收
         float radius = 50.0f;
-        circle->drawSolidCircle(Vec2::ZERO, radius, 0, 32, Color4F(0.6f, 0.0f, 0.6f, 0.6f));
+        Color4F circleColor(0.6f, 0.0f, 0.6f, 0.6f);
 
         Node* parent = this->getParent();
         if (parent)
         {
             int rangeZ = Constants::ZOrder::ENTITY - 1;
-            parent->addChild(circle, rangeZ);
-            circle->setPosition(localPos);
-            circle->setGlobalZOrder(static_cast<float>(rangeZ));
+            VfxShapes::spawnDisc(parent, localPos, radius, circleColor,
+                                 0.25f, 0.5f, rangeZ);
         }
         else if (running)
         {
             // 退回到原始实现（运行场景坐标）
             Vec2 worldPos = this->convertToWorldSpace(Vec2::ZERO);
-            running->addChild(circle, Constants::ZOrder::EFFECT);
-            circle->setPosition(worldPos);
+            VfxShapes::spawnDisc(running, worldPos, radius, circleColor,
+                                 0.25f, 0.5f, Constants::ZOrder::EFFECT);
         }
 
-        // 在圆自身上运行淡出与移除动作
-        auto fade = FadeOut::create(0.5f);
-        auto removeCircle = CallFunc::create([circle]() {
-            if (circle->getParent()) circle->removeFromParent();
-        });
-        circle->runAction(Sequence::create(DelayTime::create(0.25f), fade, removeCircle, nullptr));
-
-        // 延迟生成 KongKaZi
+        // 延迟生成 KongKaZi：生成前挂起所在房间的清房判定
         Vec2 localSpawnPos = this->getPosition();
-        auto spawnFunc = [localSpawnPos]() {
-            auto kk = KongKaZi::create();
-            if (!kk) return;
-
-            kk->setPosition(localSpawnPos);
-            kk->setTag(Constants::Tag::ENEMY);
-
-            // 尝试通过当前运行场景注册到 GameScene，以便被 updateEnemies 管理
-            auto runningInner = Director::getInstance()->getRunningScene();
-            GameScene* gs = nullptr;
-            if (runningInner)
+        Room* holdRoom = _clearRoom;
+        if (holdRoom) holdRoom->holdClear();
+        // 注册到 GameScene，以便被 updateEnemies 管理；计时器属于场景，离开场景时随之取消
+        GameScene* gs = nullptr;
+        if (running)
+        {
+            gs = dynamic_cast<GameScene*>(running);
+            if (!gs)
             {
-                gs = dynamic_cast<GameScene*>(runningInner);
-                if (!gs)
+                for (auto child : running->getChildren())
                 {
-                    for (auto child : runningInner->getChildren())
-                    {
-                        gs = dynamic_cast<GameScene*>(child);
-                        if (gs) break;
-                    }
+                    gs = dynamic_cast<GameScene*>(child);
+                    if (gs) break;
                 }
             }
+        }
+        if (!gs)
+        {
+            if (holdRoom) holdRoom->releaseClear();
+            return;
+        }
+
+        TimerWheel::getInstance()->schedule(0.28f, gs->getTimerOwner(), [localSpawnPos, holdRoom, gs]() {
+            HitchScope scope("spawnKongKaZi");
 
-            if (gs)
+            // 优先从 GameScene 的预留池取出
+            Enemy* kk = gs->acquireEnemy(EnemyKind::KONGKAZI);
+            if (kk)
             {
+                kk->setPosition(localSpawnPos);
+                kk->setTag(Constants::Tag::ENEMY);
                 gs->addEnemy(kk);
             }
-            else
-            {
-                if (runningInner)
-                {
-                    runningInner->addChild(kk);
-                }
-            }
-        };
 
-        // 使用运行场景来调度延迟
-        if (running)
-        {
-            running->runAction(Sequence::create(DelayTime::create(0.28f), CallFunc::create(spawnFunc), nullptr));
-        }
-        else
-        {
-            Director::getInstance()->getRunningScene()->runAction(Sequence::create(DelayTime::create(0.28f), CallFunc::create(spawnFunc), nullptr));
-        }
+            if (holdRoom) holdRoom->releaseClear();
+        });
     }
 }
 
@@ -509,26 +422,13 @@ int Enemy::takeDamageReported(int damage)
     }
 
     // 如果自身就是 Cup，则不再做分担检测，直接调用基类处理
-    Cup* selfCup = dynamic_cast<Cup*>(this);
-    if (selfCup)
+    if (_kind == EnemyKind::CUP)
     {
         return GameEntity::takeDamageReported(damage);
     }
 
-    // 查找任意一个在范围内且未死亡的 Cup（以第一个为准）
-    Cup* chosenCup = nullptr;
-    const auto& cups = Cup::getInstances();
-    for (auto c : cups)
-    {
-        if (!c) continue;
-        if (c->isDead()) continue;
-        float dist = c->getPosition().distance(this->getPosition());
-        if (dist <= c->getShareRadius())
-        {
-            chosenCup = c;
-            break;
-        }
-    }
+    // 查找分担范围覆盖自己的 Cup（光环索引查询，同一帧内结果缓存）
+    Cup* chosenCup = getCoveringCup();
 
     if (chosenCup)
     {
@@ -548,24 +448,7 @@ int Enemy::takeDamageReported(int damage)
         else
         {
             _hitInvulTimer = GameEntity::HIT_INVUL_DURATION;
-            if (_sprite)
-            {
-                _sprite->stopActionByTag(100);
-                _sprite->setColor(Color3B::WHITE);  // 立即重置颜色
-                _sprite->setVisible(true);
-                _sprite->setOpacity(255);
-                // 使用CallFunc+setColor瞬时设置颜色，避免TintTo渐变卡顿
-                auto setRed = CallFunc::create([this]() { _sprite->setColor(Color3B(255, 100, 100)); });
-                auto setWhite = CallFunc::create([this]() { _sprite->setColor(Color3B::WHITE); });
-                auto seq = Sequence::create(
-                    setRed, DelayTime::create(0.05f),
-                    setWhite, DelayTime::create(0.05f),
-                    setRed->clone(), DelayTime::create(0.05f),
-                    setWhite->clone(),
-                    nullptr);
-                seq->setTag(100);
-                _sprite->runAction(seq);
-            }
+            playHitFlash();
             appliedToSelf = 0;
         }
 
@@ -586,6 +469,18 @@ int Enemy::takeDamageReported(int damage)
     }
 }
 
+Cup* Enemy::getCoveringCup()
+{
+    // 索引版本号变化（新的一帧或 Cup 登记变化）或缓存的 Cup 本帧 HP 已归零时重新查询
+    unsigned int stamp = Cup::refreshAuraIndex();
+    if (_coveringCupStamp != stamp || (_coveringCup && !_coveringCup->canShare()))
+    {
+        _coveringCup = Cup::findCovering(this->getPosition());
+        _coveringCupStamp = Cup::refreshAuraIndex();  // 查询中可能已重建
+    }
+    return _coveringCup;
+}
+
 void Enemy::setRoomBounds(const cocos2d::Rect& bounds)
 {
     // 默认空实现，子类可重写以接收房间边界
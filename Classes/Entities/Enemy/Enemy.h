@@ -2,21 +2,24 @@
 #define __ENEMY_H__
 
 #include "Entities/Base/Character.h"
+#include "Entities/Enemy/EnemyKinds.h"
 #include "cocos2d.h"
 #include <vector>
 
 // 前向声明
 class Player;
+class Room;
+class Cup;
 
 // 敌人基类
 // 继承自Character，增加AI逻辑、寻路、攻击判定
 class Enemy : public Character {
 public:
-    Enemy();
+    // 子类在构造时传入自己的种类，init 时按 EnemyKinds::TABLE 设置类型、血量和移速
+    explicit Enemy(EnemyKind kind = EnemyKind::GENERIC);
     virtual ~Enemy();
 
     virtual bool init() override;
-    virtual void update(float dt) override;
 
     CREATE_FUNC(Enemy);
 
@@ -25,6 +28,17 @@ public:
     void setEnemyType(EnemyType type) { _enemyType = type; }
     EnemyType getEnemyType() const { return _enemyType; }
 
+    // 种类与特性（整数比较，替代 dynamic_cast）
+    EnemyKind getKind() const { return _kind; }
+    bool isKind(EnemyKind kind) const { return _kind == kind; }
+    const EnemyTraits& getTraits() const { return EnemyKinds::traits(_kind); }
+
+    // 按标签把节点视为敌人：只有 Enemy::init 会设置 Tag::ENEMY，非敌人返回 nullptr
+    static Enemy* asEnemy(Node* node)
+    {
+        return (node && node->getTag() == Constants::Tag::ENEMY) ? static_cast<Enemy*>(node) : nullptr;
+    }
+
     // 追击/巡逻/攻击（略）
     bool isPlayerInSight(Player* player) const;
     void chasePlayer(Player* player, float dt);
@@ -42,32 +56,51 @@ public:
     void setAttackWindup(float seconds) { _attackWindup = seconds; }
     float getAttackWindup() const { return _attackWindup; }
 
-    // 新增：是否算作房间清除计数（默认 true）
-    virtual bool countsForRoomClear() const { return true; }
+    // 是否算作房间清除计数（见特性表）
+    bool countsForRoomClear() const { return getTraits().countsForRoomClear; }
+
+    // 所属的清房计数房间（由 Room::registerEnemy 设置）
+    // 进入 DIE 状态时自动回报给该房间，每个敌人只回报一次
+    void setClearRoom(Room* room) { _clearRoom = room; }
+    Room* getClearRoom() const { return _clearRoom; }
+
+    // 覆写以在进入 DIE 状态时回报房间（覆盖 die()、Boss 强制清场等所有死亡路径）
+    virtual void setState(EntityState state) override;
+
+    // 死亡后还有收尾（死亡动画后生成铁枪/铁光杯、Boss 死亡动画）时，在进入 DIE 之前调用，
+    // 挂起所属房间的清房判定；敌人被移出场景（onExit）时自动释放，动画被强制打断也不会泄漏
+    void holdRoomClear();
+    void releaseRoomClear();
+
+    virtual void onExit() override;
 
     // Nymph 毒伤系统接口（已存在）
+    // 毒是通用状态效果 StatusEffectType::POISON（层数上限、持续时间、跳伤见 StatusEffects::TABLE）
     void applyNymphPoison(int sourceAttack);
-    int getPoisonStacks() const { return _poisonStacks; }
+    int getPoisonStacks() const { return getStatusStacks(StatusEffectType::POISON); }
+
+    // 状态跳伤由 EntityStore::tickStatus 统一推进，这里只负责表现（扣血浮字）
+    virtual void onStatusDamage(int damage, StatusEffectType type) override;
 
-    // 是否能被剧毒效果（Nymph 毒）影响。默认 true，子类可以覆写以免疫（例如 Boss 在阶段 A）。
-    virtual bool isPoisonable() const { return true; }
+    // 是否能被剧毒效果（Nymph 毒）影响。默认取特性表，子类可以覆写以按状态免疫（例如 Boss 在阶段 A）。
+    virtual bool isPoisonable() const { return getTraits().poisonable; }
 
     // Stealth（隐身） 管理
-    // 将一个隐身"来源"注册到该敌人（来源可以是烟雾 DrawNode 或其地址）
-    // 多个来源可共存；只有当来源计数从 0 => 1 时才真正设置颜色/隐身标记
-    void addStealthSource(void* source);
-    // 移除之前注册的隐身来源；当计数归零时取消隐身并恢复颜色（若有毒则恢复毒色）
-    void removeStealthSource(void* source);
+    // 隐身是按来源叠加的状态效果 StatusEffectType::STEALTH（来源可以是烟雾 DrawNode 或其地址）
+    // 多个来源可共存；着色由所有生效效果统一计算
+    void addStealthSource(void* source) { if (source) applyStatus(StatusEffectType::STEALTH, source); }
+    // 移除之前注册的隐身来源；所有来源移除后取消隐身
+    void removeStealthSource(void* source) { if (source) removeStatus(StatusEffectType::STEALTH, source); }
     // 是否当前处于隐身（至少存在一个来源）
-    bool isStealthed() const { return !_stealthSources.empty(); }
+    bool isStealthed() const { return hasStatus(StatusEffectType::STEALTH); }
 
     // 红色标记 / KongKaZi 生成功能
     // 在敌人生成后（GameScene 等处调用）尝试以概率 chance 使其泛红并获得死亡爆炸生成恐卡兹能力
     // 注意：该方法会忽略不能生成恐卡兹的敌人（例如 KongKaZi 自身）
     void tryApplyRedMark(float chance);
 
-    // 子类可覆盖以禁止自己死后生成恐卡兹（KongKaZi 应覆盖为 false）
-    virtual bool canSpawnKongKaZiOnDeath() const { return true; }
+    // 死后能否生成恐卡兹（见特性表，KongKaZi 等为 false）
+    bool canSpawnKongKaZiOnDeath() const { return getTraits().spawnsKongKaZi; }
 
     // 在敌人死亡时执行（包括生成恐卡兹逻辑），覆盖自 Character::die
     // 子类若覆写 die() 请确保在适当时机调用 Enemy::die() 以触发该通用逻辑。
@@ -79,9 +112,20 @@ public:
     // 与 takeDamage 对应的"有返回值"的版本：返回实际对该敌人造成的 HP 减少值（可用于精确显示浮动伤害）
     virtual int takeDamageReported(int damage);
 
+    // 分担范围覆盖自己的 Cup（同一帧内多次受击只查询一次光环索引），没有时返回 nullptr
+    Cup* getCoveringCup();
+
     // 设置房间边界（默认空实现），子类可覆写以接收房间边界
     virtual void setRoomBounds(const cocos2d::Rect& bounds);
 
+    // 回收复用（见特性表 reusable）：把死亡并已移出场景的实例恢复为刚 init 完成时的状态，
+    // 由 EnemyPool 在重新放入预留前调用。子类覆写时先调用基类，再恢复自己的字段、初始帧与常驻动画
+    virtual void reset();
+    bool isReusable() const { return getTraits().reusable; }
+
+    EnemyKind _kind;
+    // 敌人种类（构造时确定）
+
     EnemyType _enemyType;
     // 敌人类型
 
@@ -93,37 +137,28 @@ public:
     // 巡逻相关
     cocos2d::Vec2 _patrolTarget;
     // 巡逻目标点
-    float _patrolTimer;
-    // 巡逻计时器
+    float& _patrolTimer;
+    // 巡逻计时器（引用 EntityStore 黑板）
     float _patrolInterval;
     // 巡逻间隔
 
     // AI状态
-    bool _hasTarget;
-    // 是否有目标
+    bool& _hasTarget;
+    // 是否有目标（引用 EntityStore 黑板）
 
     // 攻击前摇（windup）时长（秒），默认 0.5f
     float _attackWindup;
-    // Nymph 中毒状态
-    int _poisonStacks;
-    float _poisonTimer;
-    float _poisonTickAcc;
-    int _poisonSourceAttack;
-    cocos2d::Color3B _poisonOriginalColor;
-    bool _poisonColorSaved;
-    static const int POISON_MAX_STACKS = 100;
-    static constexpr float POISON_DURATION = 10.0f;
-    static constexpr float POISON_TICK_INTERVAL = 0.5f;
-    static constexpr float POISON_TICK_RATIO = 0.1f;
-    // 每层每次造成源攻击 10%
-
-    // Stealth 源列表（支持多来源）
-    std::vector<void*> _stealthSources;
-    cocos2d::Color3B _stealthOriginalColor;
-    bool _stealthColorSaved;
-
     // 红色标记
     bool _isRedMarked;
+
+    // 覆盖自己的 Cup 缓存（_coveringCupStamp 与 Cup 光环索引版本一致时有效）
+    Cup* _coveringCup;
+    unsigned int _coveringCupStamp;
+
+    // 清房计数房间（弱引用，房间生命周期覆盖整个场景）
+    Room* _clearRoom;
+    // 当前挂起清房判定的房间
+    Room* _clearHoldRoom;
 };
 
 #endif // __ENEMY_H__
@@ -0,0 +1,105 @@
+﻿#include "EnemyKinds.h"
+#include "Entities/Enemy/Enemy.h"
+#include "Entities/Enemy/Ayao.h"
+#include "Entities/Enemy/DeYi.h"
+#include "Entities/Enemy/XinXing.h"
+#include "Entities/Enemy/TangHuang.h"
+#include "Entities/Enemy/Du.h"
+#include "Entities/Enemy/Cup.h"
+#include "Entities/Enemy/Boat.h"
+#include "Entities/Enemy/KongKaZi.h"
+#include "Entities/Enemy/IronLance.h"
+#include "Entities/Enemy/IronLightCup.h"
+#include "Entities/Enemy/NiLuFire.h"
+#include "Entities/Enemy/KuiLongBoss.h"
+
+namespace {
+    template <typename T>
+    Enemy* createAs()
+    {
+        return T::create();
+    }
+
+    typedef Enemy* (*EnemyFactory)();
+
+    // 工厂表，按 EnemyKind 顺序排列
+    constexpr EnemyFactory FACTORIES[] = {
+        &createAs<Enemy>,
+        &createAs<Ayao>,
+        &createAs<DeYi>,
+        &createAs<XinXing>,
+        &createAs<TangHuang>,
+        &createAs<Du>,
+        &createAs<Cup>,
+        &createAs<Boat>,
+        &createAs<KongKaZi>,
+        &createAs<IronLance>,
+        &createAs<IronLightCup>,
+        &createAs<NiLuFire>,
+        &createAs<KuiLongBoss>,
+    };
+    static_assert(sizeof(FACTORIES) / sizeof(FACTORIES[0]) == static_cast<size_t>(EnemyKind::COUNT),
+                  "FACTORIES must have one entry per EnemyKind");
+
+    EnemyKind pickWeighted(float EnemyTraits::*weight, float r)
+    {
+        float total = 0.0f;
+        for (const auto& row : EnemyKinds::TABLE) total += row.*weight;
+
+        float acc = 0.0f;
+        float target = r * total;
+        EnemyKind last = EnemyKind::GENERIC;
+        for (int i = 0; i < static_cast<int>(EnemyKind::COUNT); i++)
+        {
+            float w = EnemyKinds::TABLE[i].*weight;
+            if (w <= 0.0f) continue;
+            last = static_cast<EnemyKind>(i);
+            acc += w;
+            if (target < acc) return last;
+        }
+        return last;
+    }
+}
+
+Enemy* EnemyKinds::create(EnemyKind kind)
+{
+    if (kind >= EnemyKind::COUNT) return nullptr;
+    return FACTORIES[static_cast<int>(kind)]();
+}
+
+EnemyKind EnemyKinds::pickRoomSpawn(float r)
+{
+    return pickWeighted(&EnemyTraits::roomSpawnWeight, r);
+}
+
+EnemyKind EnemyKinds::pickBossSpawn(float r)
+{
+    return pickWeighted(&EnemyTraits::bossSpawnWeight, r);
+}
+
+void EnemyKinds::collectLevelKinds(bool bossFloor, std::vector<EnemyKind>& out)
+{
+    bool present[static_cast<int>(EnemyKind::COUNT)] = {};
+    std::vector<EnemyKind> candidates;
+
+    for (int i = 0; i < static_cast<int>(EnemyKind::COUNT); i++)
+    {
+        if (TABLE[i].roomSpawnWeight > 0.0f || (bossFloor && TABLE[i].bossSpawnWeight > 0.0f))
+        {
+            candidates.push_back(static_cast<EnemyKind>(i));
+        }
+    }
+    candidates.push_back(EnemyKind::KONGKAZI);
+    if (bossFloor)
+    {
+        candidates.push_back(EnemyKind::KUILONG_BOSS);
+        KuiLongBoss::collectSummonKinds(candidates);
+    }
+
+    for (EnemyKind kind : candidates)
+    {
+        if (present[static_cast<int>(kind)]) continue;
+        present[static_cast<int>(kind)] = true;
+        out.push_back(kind);
+    }
+}
@@ -0,0 +1,62 @@
+﻿#ifndef __ENEMY_KINDS_H__
+#define __ENEMY_KINDS_H__
+
+#include "Core/Constants.h"
+#include "Core/GameMacros.h"
+#include <cstddef>
+#include <vector>
+
+class Enemy;
+
+// 敌人种类特性
+struct EnemyTraits {
+    const char* name;
+    EnemyType type;
+    int maxHP;
+    float moveSpeed;
+    bool countsForRoomClear;   // 是否计入清房
+    bool poisonable;           // 默认是否可被剧毒影响（Boss 按阶段覆写）
+    bool spawnsKongKaZi;       // 红色标记后死亡是否生成恐卡兹
+    float roomSpawnWeight;     // 普通房间生成权重
+    float bossSpawnWeight;     // Boss 房初始小怪生成权重
+    bool reusable;             // 实现了 Enemy::reset()，死亡后由 EnemyPool 回收复用
+    const char* assetDir;      // 纹理目录（关卡资源清单按本层可能出现的种类收集，空串表示无专属资源）
+};
+
+namespace EnemyKinds {
+    // 特性表，按 EnemyKind 顺序排列
+    constexpr EnemyTraits TABLE[] = {
+        // name            type                maxHP   speed   clear  poison kkz    room   boss   reuse  assets
+        { "Enemy",        EnemyType::MELEE,  Constants::Enemy::MELEE_HP, Constants::Enemy::DEFAULT_MOVE_SPEED,
+                                                               true,  true,  true,  0.0f,  0.0f,  false, "" },
+        { "Ayao",         EnemyType::MELEE,   1000,   100.0f, true,  true,  true,  17.5f, 25.0f, false, "Enemy/AYao" },
+        { "DeYi",         EnemyType::MELEE,   1000,   140.0f, true,  true,  true,  17.5f, 0.0f,  true,  "Enemy/DeYi" },
+        { "XinXing",      EnemyType::MELEE,   6000,   120.0f, true,  true,  true,  17.5f, 0.0f,  true,  "Enemy/XinXing&&Iron Lance" },
+        { "TangHuang",    EnemyType::MELEE,   5000,   70.0f,  true,  true,  true,  17.5f, 25.0f, true,  "Enemy/TangHuang&&Iron LightCup" },
+        { "Du",           EnemyType::RANGED,  3500,   65.0f,  true,  true,  true,  15.0f, 25.0f, true,  "Enemy/Du" },
+        { "Cup",          EnemyType::MELEE,   300000, 80.0f,  true,  true,  false, 15.0f, 25.0f, false, "Enemy/Cup" },
+        { "Boat",         EnemyType::MELEE,   600000, 150.0f, false, true,  false, 0.0f,  0.0f,  true,  "Enemy/Boat" },
+        { "KongKaZi",     EnemyType::MELEE,   5000,   150.0f, true,  true,  false, 0.0f,  0.0f,  false, "Enemy/KongKaZi" },
+        { "IronLance",    EnemyType::MELEE,   15,     60.0f,  true,  true,  true,  0.0f,  0.0f,  true,  "Enemy/XinXing&&Iron Lance" },
+        { "IronLightCup", EnemyType::MELEE,   10,     40.0f,  true,  true,  true,  0.0f,  0.0f,  true,  "Enemy/TangHuang&&Iron LightCup" },
+        { "NiLuFire",     EnemyType::MELEE,   2000,   0.0f,   false, true,  false, 0.0f,  0.0f,  false, "Enemy/NiLu Fire" },
+        { "KuiLongBoss",  EnemyType::MELEE,   300000, 30.0f,  true,  true,  false, 0.0f,  0.0f,  false, "Enemy/_BOSS_KuiLong" },
+    };
+    static_assert(sizeof(TABLE) / sizeof(TABLE[0]) == static_cast<size_t>(EnemyKind::COUNT),
+                  "EnemyKinds::TABLE must have one row per EnemyKind");
+
+    constexpr const EnemyTraits& traits(EnemyKind kind) { return TABLE[static_cast<int>(kind)]; }
+
+    // 按种类创建敌人（已 autorelease）
+    Enemy* create(EnemyKind kind);
+
+    // 按权重随机选择普通房间 / Boss 房初始小怪的种类，r 取 [0, 1)
+    EnemyKind pickRoomSpawn(float r);
+    EnemyKind pickBossSpawn(float r);
+
+    // 本层可能出现的种类（与 GameScene::initEnemyPool 的预留一致，去重）：
+    // 普通房间权重非零的种类与恐卡兹；Boss 层另加 Boss、Boss 房初始小怪与 Boss 各阶段召唤物
+    void collectLevelKinds(bool bossFloor, std::vector<EnemyKind>& out);
+}
+
+#endif // __ENEMY_KINDS_H__
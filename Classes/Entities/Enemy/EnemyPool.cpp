@@ -0,0 +1,114 @@
+﻿#include "EnemyPool.h"
+#include "Entities/Enemy/Enemy.h"
+#include <chrono>
+#include <cmath>
+
+EnemyPool::EnemyPool()
+    : _misses(0)
+{
+    for (int i = 0; i < KIND_COUNT; i++)
+    {
+        _target[i] = 0;
+    }
+}
+
+EnemyPool::~EnemyPool()
+{
+    clear();
+}
+
+void EnemyPool::addTarget(EnemyKind kind, int count)
+{
+    if (kind >= EnemyKind::COUNT || count <= 0) return;
+    _target[static_cast<int>(kind)] += count;
+}
+
+void EnemyPool::addWeightedTarget(float EnemyTraits::*weight, int budget)
+{
+    float total = 0.0f;
+    for (const auto& row : EnemyKinds::TABLE) total += row.*weight;
+    if (total <= 0.0f) return;
+
+    for (int i = 0; i < KIND_COUNT; i++)
+    {
+        float w = EnemyKinds::TABLE[i].*weight;
+        if (w <= 0.0f) continue;
+        int expected = static_cast<int>(std::ceil(budget * w / total));
+        addTarget(static_cast<EnemyKind>(i), expected + 1);
+    }
+}
+
+bool EnemyPool::prewarm(float budgetMs)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < KIND_COUNT; i++)
+    {
+        while (static_cast<int>(_reserve[i].size()) < _target[i])
+        {
+            Enemy* enemy = EnemyKinds::create(static_cast<EnemyKind>(i));
+            if (!enemy)
+            {
+                GAME_LOG_ERROR("EnemyPool: failed to create %s", EnemyKinds::TABLE[i].name);
+                _target[i] = static_cast<int>(_reserve[i].size());
+                break;
+            }
+            _reserve[i].pushBack(enemy);
+
+            if (budgetMs > 0.0f)
+            {
+                float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (elapsed >= budgetMs) return false;
+            }
+        }
+    }
+    return true;
+}
+
+Enemy* EnemyPool::acquire(EnemyKind kind)
+{
+    if (kind >= EnemyKind::COUNT) return nullptr;
+
+    auto& reserve = _reserve[static_cast<int>(kind)];
+    if (reserve.empty())
+    {
+        _misses++;
+        GAME_LOG("EnemyPool: reserve empty for %s, creating on demand (misses=%d)", EnemyKinds::traits(kind).name, _misses);
+        return EnemyKinds::create(kind);
+    }
+
+    // 先 retain + autorelease 再移出容器，交给调用方时与 create() 的引用计数一致
+    Enemy* enemy = reserve.back();
+    enemy->retain();
+    enemy->autorelease();
+    reserve.popBack();
+    return enemy;
+}
+
+void EnemyPool::recycle(Enemy* enemy)
+{
+    if (!enemy || !enemy->isReusable()) return;
+    if (_dying.contains(enemy)) return;
+    _dying.pushBack(enemy);
+}
+
+void EnemyPool::reclaim()
+{
+    for (ssize_t i = _dying.size() - 1; i >= 0; i--)
+    {
+        Enemy* enemy = _dying.at(i);
+        if (enemy->getParent()) continue;   // 死亡动画结束后才会移出场景
+
+        enemy->reset();
+        _reserve[static_cast<int>(enemy->getKind())].pushBack(enemy);
+        _dying.erase(i);
+    }
+}
+
+void EnemyPool::clear()
+{
+    for (int i = 0; i < KIND_COUNT; i++)
+    {
+        _reserve[i].clear();
+    }
+    _dying.clear();
+}
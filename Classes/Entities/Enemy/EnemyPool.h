@@ -0,0 +1,62 @@
+﻿#ifndef __ENEMY_POOL_H__
+#define __ENEMY_POOL_H__
+
+#include "cocos2d.h"
+#include "Entities/Enemy/EnemyKinds.h"
+
+USING_NS_CC;
+
+class Enemy;
+
+// 按种类预留的敌人实例池（由 GameScene 持有）
+// 关卡加载时按房间的敌人预算预先 create 好实例（精灵、动画在 init 中完成），
+// 战斗中生成敌人直接取出，避免在战斗帧里分配和创建精灵。
+// 特性表中 reusable 的种类（Boss 召唤物及其死亡生成物）死亡后交回池中，
+// 死亡收尾结束、移出场景后经 Enemy::reset() 恢复并重新放入预留；其余种类随死亡销毁，
+// 预留只在没有存活敌人的非战斗帧按时间预算补齐，战斗中不创建新实例。
+class EnemyPool {
+public:
+    EnemyPool();
+    ~EnemyPool();
+
+    // 普通房间最多生成的敌人数（与 GameScene::spawnEnemiesInRoom 一致）
+    static const int ROOM_ENEMY_BUDGET = 8;
+    // Boss 房初始小怪数
+    static const int BOSS_MINION_BUDGET = 30;
+    // 非战斗帧补齐预留的每帧时间预算（毫秒）
+    static constexpr float REFILL_BUDGET_MS = 2.0f;
+
+    // 增加某种类的目标预留数
+    void addTarget(EnemyKind kind, int count);
+    // 按生成权重把 budget 个敌人分摊到各种类的目标预留上（每种额外多留 1 个）
+    void addWeightedTarget(float EnemyTraits::*weight, int budget);
+
+    // 补齐预留；budgetMs > 0 时超出预算即停止，剩余的下次继续
+    // 返回是否已全部补齐
+    bool prewarm(float budgetMs = 0.0f);
+
+    // 取出一个敌人（autorelease，与 create() 语义一致）；预留不足时直接创建并计入 misses
+    Enemy* acquire(EnemyKind kind);
+
+    // 交回已死亡的敌人（非 reusable 种类忽略）；仍在播放死亡收尾时先暂存
+    void recycle(Enemy* enemy);
+    // 把已移出场景的暂存实例 reset 后放回预留（每帧调用，无暂存时没有开销）
+    void reclaim();
+
+    // 释放全部预留
+    void clear();
+
+    int getReserved(EnemyKind kind) const { return static_cast<int>(_reserve[static_cast<int>(kind)].size()); }
+    int getTarget(EnemyKind kind) const { return _target[static_cast<int>(kind)]; }
+    int getMisses() const { return _misses; }
+
+private:
+    static const int KIND_COUNT = static_cast<int>(EnemyKind::COUNT);
+
+    Vector<Enemy*> _reserve[KIND_COUNT];
+    Vector<Enemy*> _dying;      // 已交回、尚在播放死亡收尾的实例
+    int _target[KIND_COUNT];
+    int _misses;
+};
+
+#endif // __ENEMY_POOL_H__
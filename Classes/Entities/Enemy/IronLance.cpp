@@ -70,7 +70,8 @@ static Vector<SpriteFrame*> tryLoadFramesFromPatterns(const std::vector<std::str
 }
 
 IronLance::IronLance()
-    : _moveAnimation(nullptr)
+    : Enemy(EnemyKind::IRON_LANCE)
+    , _moveAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _roomBounds(Rect::ZERO)
     , _hasRoomBounds(false)
@@ -87,14 +88,8 @@ bool IronLance::init()
 {
     if (!Enemy::init()) return false;
 
-    setEnemyType(EnemyType::MELEE);
-
-    // 基础属性
-    setMaxHP(15);
-    setHP(15);
-
+    // 基础属性（血量与移速见 EnemyKinds::TABLE）
     setAttack(0);
-    setMoveSpeed(60.0f);
 
     // 不索敌、不攻击
     setSightRange(0.0f);
@@ -286,6 +281,7 @@ void IronLance::die()
     // 设置为死亡状态并停止动作
     setState(EntityState::DIE);
     this->stopAllActions();
+    cancelAllTimers();
     if (_sprite)
     {
         _sprite->stopAllActions();
@@ -315,10 +311,24 @@ void IronLance::die()
     {
         // 使用基类的死亡效果并在结束后移除节点
         Character::die(); // 会调用 showDeathEffect()
-        auto removeCallback = CallFunc::create([this]() {
+        // showDeathEffect 的动画大约 0.5s，延迟稍长以确保视觉完成
+        scheduleTimer(0.55f, [this]() {
             if (this->getParent()) this->removeFromParent();
         });
-        // showDeathEffect 的动画大约 0.5s，延迟稍长以确保视觉完成
-        this->runAction(Sequence::create(DelayTime::create(0.55f), removeCallback, nullptr));
+    }
+}
+
+void IronLance::reset()
+{
+    Enemy::reset();
+
+    _roomBounds = Rect::ZERO;
+    _hasRoomBounds = false;
+
+    // 没有死亡动画时走 showDeathEffect（精灵缩到 0），恢复缩放与移动动画第一帧
+    if (_sprite) _sprite->setScale(1.0f);
+    if (_sprite && _moveAnimation && !_moveAnimation->getFrames().empty())
+    {
+        _sprite->setSpriteFrame(_moveAnimation->getFrames().front()->getSpriteFrame());
     }
 }
\ No newline at end of file
@@ -15,9 +15,6 @@ public:
 
     CREATE_FUNC(IronLance);
 
-    // 现在算作房间清除计数（改为 true）
-    virtual bool countsForRoomClear() const override { return true; }
-
     // 仅移动（覆写 AI）
     virtual void executeAI(Player* player, float dt) override;
 
@@ -28,6 +25,7 @@ public:
 
     // 覆写 die()，确保死亡时执行视觉播放 + 清理
     virtual void die() override;
+    virtual void reset() override;
 
     // 房间边界
     virtual void setRoomBounds(const cocos2d::Rect& bounds) override { _roomBounds = bounds; _hasRoomBounds = true; }
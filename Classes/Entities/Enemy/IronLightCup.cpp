@@ -9,7 +9,8 @@ static const int IRONLIGHT_MOVE_ACTION_TAG = 0x6E01;
 static const int IRONLIGHT_DIE_ACTION_TAG  = 0x6E02;
 
 IronLightCup::IronLightCup()
-    : _moveAnimation(nullptr)
+    : Enemy(EnemyKind::IRON_LIGHT_CUP)
+    , _moveAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _roomBounds(Rect::ZERO)
     , _hasRoomBounds(false)
@@ -29,13 +30,7 @@ bool IronLightCup::init()
 {
     if (!Enemy::init()) return false;
 
-    setEnemyType(EnemyType::MELEE);
-
-    // 设置为“35 次击中死亡”（通过单次扣血实现）
-    setMaxHP(10);
-    setHP(getMaxHP());
-
-    setMoveSpeed(40.0f);
+    // 血量与移速见 EnemyKinds::TABLE（“35 次击中死亡”通过单次扣血实现）
 
     // 无视野/攻击相关（不会主动寻敌）
     setSightRange(0.0f);
@@ -244,4 +239,24 @@ void IronLightCup::die()
 
     // 没有死亡动画则直接移除
     this->removeFromParentAndCleanup(true);
+}
+
+void IronLightCup::reset()
+{
+    Enemy::reset();
+
+    _roomBounds = Rect::ZERO;
+    _hasRoomBounds = false;
+    _patrolInterval = 0.8f + CCRANDOM_0_1() * 1.2f;
+    _patrolTimer = 0.0f;
+    _patrolDirection = Vec2::ZERO;
+
+    // 与 init 一致：从第一帧开始循环播放移动动画
+    if (_sprite && _moveAnimation && !_moveAnimation->getFrames().empty())
+    {
+        _sprite->setSpriteFrame(_moveAnimation->getFrames().front()->getSpriteFrame());
+        auto repeat = RepeatForever::create(Animate::create(_moveAnimation));
+        repeat->setTag(IRONLIGHT_MOVE_ACTION_TAG);
+        _sprite->runAction(repeat);
+    }
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ public:
     virtual int takeDamageReported(int damage) override;
 
     virtual void die() override;
+    virtual void reset() override;
 
     virtual void setRoomBounds(const cocos2d::Rect& bounds) override { _roomBounds = bounds; _hasRoomBounds = true; }
 
@@ -6,7 +6,8 @@ static const int KONG_HIT_ACTION_TAG  = 0xB002; // 命中/伤害播放动作 tag
 static const int KONG_WINDUP_ACTION_TAG = 0xB003; // 攻击前摇动作 tag
 
 KongKaZi::KongKaZi()
-    : _moveAnimation(nullptr)
+    : Enemy(EnemyKind::KONGKAZI)
+    , _moveAnimation(nullptr)
     , _attackAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _roomBounds(cocos2d::Rect::ZERO)
@@ -28,9 +29,6 @@ bool KongKaZi::init()
         return false;
     }
 
-    // 设置敌人类型（近战）
-    setEnemyType(EnemyType::MELEE);
-
     setupKongKaZiAttributes();
     loadAnimations();
 
@@ -72,10 +70,7 @@ void KongKaZi::update(float dt)
 void KongKaZi::setupKongKaZiAttributes()
 {
     // 设置基础属性（可根据需要调整数值）
-    setMaxHP(5000);
-    setHP(5000);
     setAttack(750);
-    setMoveSpeed(150.0f);
 
     // AI 参数
     setSightRange(1000.0f);
@@ -176,28 +171,22 @@ void KongKaZi::attack()
         _sprite->runAction(animate);
 
         float windup = this->getAttackWindup();
-        auto delay = DelayTime::create(windup);
-        auto callback = CallFunc::create([this]() {
+        scheduleTimer(windup, [this]() {
             if (_currentState == EntityState::ATTACK)
             {
                 setState(EntityState::IDLE);
             }
         });
-        auto seq = Sequence::create(delay, callback, nullptr);
-        this->runAction(seq);
     }
     else
     {
         float windup = this->getAttackWindup();
-        auto delay = DelayTime::create(windup);
-        auto callback = CallFunc::create([this]() {
+        scheduleTimer(windup, [this]() {
             if (_currentState == EntityState::ATTACK)
             {
                 setState(EntityState::IDLE);
             }
         });
-        auto seq = Sequence::create(delay, callback, nullptr);
-        this->runAction(seq);
     }
 }
 
@@ -217,6 +206,7 @@ void KongKaZi::die()
     // 标记为不存活
     // 停止所有动作
     this->stopAllActions();
+    cancelAllTimers();
     if (_sprite)
     {
         _sprite->stopAllActions();
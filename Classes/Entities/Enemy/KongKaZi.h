@@ -25,9 +25,6 @@ public:
     virtual void move(const cocos2d::Vec2& direction, float dt) override;
     virtual void playAttackAnimation() override;
 
-    // 覆盖以阻止从自身生成恐卡兹
-    virtual bool canSpawnKongKaZiOnDeath() const override { return false; }
-
     void setRoomBounds(const cocos2d::Rect& bounds) { _roomBounds = bounds; _hasRoomBounds = true; }
 
 protected:
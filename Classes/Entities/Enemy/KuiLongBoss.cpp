@@ -5,23 +5,68 @@
 #include "Entities/Enemy/NiLuFire.h"
 #include "Entities/Enemy/Boat.h"
 #include "Scenes/GameScene.h"
-#include "UI/FloatingText.h"
+#include "Entities/Base/DamageQueue.h"
 #include "Map/Room.h"
 
-// 引入怪物头文件
-#include "Entities/Enemy/Du.h"
-#include "Entities/Enemy/Ayao.h"
-#include "Entities/Enemy/Cup.h"
-#include "Entities/Enemy/TangHuang.h"
-#include "Entities/Enemy/DeYi.h"
-#include "Entities/Enemy/XinXing.h"
+// 小怪按种类从 GameScene 的预留池取出
+#include "Entities/Enemy/EnemyKinds.h"
+#include "Entities/Enemy/EnemyPool.h"
+#include "Utils/LeakTracker.h"
 
 USING_NS_CC;
 
 static const char* LOG_TAG = "KuiLongBoss";
 
+namespace {
+    struct MinionWave {
+        EnemyKind kind;
+        int count;
+    };
+
+    // 二阶段召唤：8个得意，2个新硎，3个堂皇，4个妒
+    const MinionWave PHASE_B_WAVE[] = {
+        { EnemyKind::DEYI, 8 },
+        { EnemyKind::XINXING, 2 },
+        { EnemyKind::TANGHUANG, 3 },
+        { EnemyKind::DU, 4 },
+    };
+
+    // 承三身召唤：8个得意，4个妒，4个新硎，2个堂皇
+    const MinionWave CHENG_SAN_SHEN_WAVE[] = {
+        { EnemyKind::DEYI, 8 },
+        { EnemyKind::DU, 4 },
+        { EnemyKind::XINXING, 4 },
+        { EnemyKind::TANGHUANG, 2 },
+    };
+
+    const float MINION_SPAWN_RADIUS = 600.0f;
+
+    // 承无解：5 段伤害，段间隔依次为 0.5 / 0.5 / 0.5 / 1.0 秒
+    const int CHENG_WU_JIE_HIT_COUNT = 5;
+    const float CHENG_WU_JIE_HIT_GAPS[CHENG_WU_JIE_HIT_COUNT - 1] = { 0.5f, 0.5f, 0.5f, 1.0f };
+}
+
+void KuiLongBoss::reserveMinions(EnemyPool& pool)
+{
+    // 召唤物死亡后由预留池回收复用，战斗中不再创建：
+    // 二阶段周期召唤预留两波（上一波未清完时下一波仍能命中预留），承三身一波，
+    // 承三身与周期召唤各带一艘 Boat
+    for (const auto& wave : PHASE_B_WAVE) pool.addTarget(wave.kind, wave.count * 2);
+    for (const auto& wave : CHENG_SAN_SHEN_WAVE) pool.addTarget(wave.kind, wave.count);
+    pool.addTarget(EnemyKind::BOAT, 2);
+}
+
+void KuiLongBoss::collectSummonKinds(std::vector<EnemyKind>& out)
+{
+    for (const auto& wave : PHASE_B_WAVE) out.push_back(wave.kind);
+    for (const auto& wave : CHENG_SAN_SHEN_WAVE) out.push_back(wave.kind);
+    out.push_back(EnemyKind::BOAT);
+    out.push_back(EnemyKind::NILU_FIRE);
+}
+
 KuiLongBoss::KuiLongBoss()
-    : _phase(PHASE_A)
+    : Enemy(EnemyKind::KUILONG_BOSS)
+    , _phase(PHASE_A)
     , _phaseTimer(0.0f)
     , _phaseADuration(60.0f)
     , _phaseCIdleTimer(0.0f)
@@ -47,6 +92,8 @@ KuiLongBoss::KuiLongBoss()
     , _skillDamagePerHit(getAttack() * 4)
     , _skillPlaying(false)
     , _skillDamageScheduled(false)
+    , _windupTimer(TimerWheel::INVALID_HANDLE)
+    , _skillDamageTimer(TimerWheel::INVALID_HANDLE)
     , _roomBounds(Rect::ZERO)
     , _phase3Room(nullptr)
     , _niluSpawnTimer(0.0f)
@@ -78,8 +125,8 @@ void KuiLongBoss::setRoomBounds(const Rect& bounds)
 static void collectNiLuFiresRecursive(cocos2d::Node* node, std::vector<class NiLuFire*>& out)
 {
     if (!node) return;
-    NiLuFire* fire = dynamic_cast<NiLuFire*>(node);
-    if (fire) out.push_back(fire);
+    Enemy* enemy = Enemy::asEnemy(node);
+    if (enemy && enemy->isKind(EnemyKind::NILU_FIRE)) out.push_back(static_cast<NiLuFire*>(enemy));
     const auto& children = node->getChildren();
     for (auto child : children) collectNiLuFiresRecursive(child, out);
 }
@@ -162,10 +209,6 @@ bool KuiLongBoss::init()
 {
     if (!Enemy::init()) return false;
 
-    setEnemyType(EnemyType::MELEE);
-    setMaxHP(300000);
-    setHP(getMaxHP());
-    setMoveSpeed(30.0f);
     setAttack(1800);
     setSightRange(10000.0f);
     setAttackRange(120.0f);
@@ -210,9 +253,6 @@ bool KuiLongBoss::init()
     {
         float barWidth = 120.0f;
         float barHeight = 10.0f;
-        float bgGlobalZ = static_cast<float>(Constants::ZOrder::FLOOR + 1);
-        float fillGlobalZ = static_cast<float>(Constants::ZOrder::FLOOR + 2);
-        float labelGlobalZ = static_cast<float>(Constants::ZOrder::FLOOR + 3);
 
         auto bg = Sprite::create("UIs/StatusBars/Bars/EmplyBar.png");
         if (bg) {
@@ -220,7 +260,6 @@ bool KuiLongBoss::init()
             bg->setScaleX(barWidth / bg->getContentSize().width);
             bg->setScaleY(barHeight / bg->getContentSize().height);
             bg->setPosition(Vec2(0.0f, -(_sprite ? _sprite->getBoundingBox().size.height * 0.5f : 24.0f) - _bossBarOffsetY));
-            bg->setGlobalZOrder(bgGlobalZ);
             this->addChild(bg, 0);
         }
 
@@ -231,7 +270,6 @@ bool KuiLongBoss::init()
             _bossHPBar->setScaleX(barWidth / _bossHPBar->getContentSize().width);
             _bossHPBar->setScaleY(barHeight / _bossHPBar->getContentSize().height);
             _bossHPBar->setPosition(Vec2(0.0f, -(_sprite ? _sprite->getBoundingBox().size.height * 0.5f : 24.0f) - _bossBarOffsetY));
-            _bossHPBar->setGlobalZOrder(fillGlobalZ);
             this->addChild(_bossHPBar, 1);
         }
 
@@ -242,7 +280,6 @@ bool KuiLongBoss::init()
             _bossHPLabel->setAnchorPoint(Vec2(0.5f, 0.5f));
             _bossHPLabel->setTextColor(Color4B::WHITE);
             _bossHPLabel->setPosition(Vec2(0.0f, -(_sprite ? _sprite->getBoundingBox().size.height * 0.5f : 24.0f) - _bossBarOffsetY - 12.0f));
-            _bossHPLabel->setGlobalZOrder(labelGlobalZ);
             this->addChild(_bossHPLabel, 2);
         }
     }
@@ -253,35 +290,35 @@ bool KuiLongBoss::init()
 void KuiLongBoss::loadAnimations()
 {
     _animAIdle = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_A_Idle", "KL_A_Idle", 8, 0.12f);
-    if (_animAIdle) _animAIdle->retain();
+    if (_animAIdle) { _animAIdle->retain(); LEAK_TRACK_RETAIN(_animAIdle); }
 
     _animAChangeToB = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_A_ChangeToB", "KL_A_ChangeToB", 12, 0.08f);
-    if (_animAChangeToB) _animAChangeToB->retain();
+    if (_animAChangeToB) { _animAChangeToB->retain(); LEAK_TRACK_RETAIN(_animAChangeToB); }
 
     _animBMove = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_B_Move", "KL_B_Move", 7, 0.10f);
-    if (_animBMove) _animBMove->retain();
+    if (_animBMove) { _animBMove->retain(); LEAK_TRACK_RETAIN(_animBMove); }
 
     _animBAttack = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_B_Attack", "KL_B_Attack", 12, 0.10f);
-    if (_animBAttack) _animBAttack->retain();
+    if (_animBAttack) { _animBAttack->retain(); LEAK_TRACK_RETAIN(_animBAttack); }
 
     _animBChangeToC = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_B_ChangeToC", "KL_B_ChangeTo_C", 13, 0.10f);
-    if (_animBChangeToC) _animBChangeToC->retain();
+    if (_animBChangeToC) { _animBChangeToC->retain(); LEAK_TRACK_RETAIN(_animBChangeToC); }
 
     _animBChengWuJie = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_B_Skill2ChengWuJie", "KL_B_Skill2", 23, 0.10f);
-    if (_animBChengWuJie) _animBChengWuJie->retain();
+    if (_animBChengWuJie) { _animBChengWuJie->retain(); LEAK_TRACK_RETAIN(_animBChengWuJie); }
 
     _animCSS_Start = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_B_Skill1ChengSanShen_Start", "KL_B_Skill1_Start", 10, 0.1f);
-    if (_animCSS_Start) _animCSS_Start->retain();
+    if (_animCSS_Start) { _animCSS_Start->retain(); LEAK_TRACK_RETAIN(_animCSS_Start); }
 
     _animCSS_Idle = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_B_Skill1ChengSanShen_Idle", "KL_B_Skill1_Idle", 8, 0.1f);
-    if (_animCSS_Idle) _animCSS_Idle->retain();
+    if (_animCSS_Idle) { _animCSS_Idle->retain(); LEAK_TRACK_RETAIN(_animCSS_Idle); }
 
     _animCSS_End = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_B_Skill1ChengSanShen_End", "KL_B_Skill1_End", 10, 0.1f);
-    if (_animCSS_End) _animCSS_End->retain();
+    if (_animCSS_End) { _animCSS_End->retain(); LEAK_TRACK_RETAIN(_animCSS_End); }
 
     // 3阶段死亡动画
     _animCDie = loadAnimationFrames("Enemy/_BOSS_KuiLong/Boss_C_Die", "KL_C_Die", 20, 0.1f);
-    if (_animCDie) _animCDie->retain();
+    if (_animCDie) { _animCDie->retain(); LEAK_TRACK_RETAIN(_animCDie); }
 }
 
 bool KuiLongBoss::isPoisonable() const
@@ -468,15 +505,14 @@ void KuiLongBoss::attack()
         if (moveAct) _sprite->stopAction(moveAct);
         _moveAnimPlaying = false;
     }
-    this->stopActionByTag(KUI_LONG_WINDUP_TAG);
+    cancelTimer(_windupTimer);
     if (_sprite) {
         auto prevWind = _sprite->getActionByTag(KUI_LONG_WINDUP_TAG);
         if (prevWind) _sprite->stopAction(prevWind);
     }
 
     float windup = this->getAttackWindup();
-    auto delay = DelayTime::create(windup);
-    auto startAttackAnim = CallFunc::create([this]() {
+    _windupTimer = scheduleTimer(windup, [this]() {
         Scene* running = Director::getInstance()->getRunningScene();
         if (running) {
             GameScene* gs = dynamic_cast<GameScene*>(running);
@@ -486,11 +522,7 @@ void KuiLongBoss::attack()
                     float distSqr = (player->getPosition() - this->getPosition()).lengthSquared();
                     if (distSqr <= (this->getAttackRange() * this->getAttackRange())) {
                         int dmg = this->getAttack();
-                        player->takeDamage(dmg);
-                        Node* parentForText = player->getParent() ? player->getParent() : running;
-                        if (parentForText) {
-                            FloatingText::show(parentForText, player->getPosition(), std::to_string(dmg), Color3B(220,20,20));
-                        }
+                        DamageQueue::getInstance()->push(player, dmg, Color3B(220,20,20));
                     }
                 }
             }
@@ -506,9 +538,6 @@ void KuiLongBoss::attack()
         }
         this->playAttackAnimation();
     });
-    auto seq = Sequence::create(delay, startAttackAnim, nullptr);
-    seq->setTag(KUI_LONG_WINDUP_TAG);
-    this->runAction(seq);
 }
 
 void KuiLongBoss::playAttackAnimation()
@@ -638,6 +667,7 @@ void KuiLongBoss::startChengSanShen()
     _escalationLevel++;
 
     stopAllActions();
+    cancelAllTimers();
     if (_sprite) _sprite->stopAllActions();
     _moveAnimPlaying = false;
     _skillPlaying = false;
@@ -657,8 +687,10 @@ void KuiLongBoss::startChengSanShen()
                 _sprite->runAction(repeat);
             }
             // 召唤 Boat (承三身技能自带的 Boat)
-            if (!_roomBounds.equals(Rect::ZERO)) {
-                auto boat = Boat::create();
+            auto scene = Director::getInstance()->getRunningScene();
+            auto gs = dynamic_cast<GameScene*>(scene);
+            if (gs && !_roomBounds.equals(Rect::ZERO)) {
+                auto boat = static_cast<Boat*>(gs->acquireEnemy(EnemyKind::BOAT));
                 if (boat) {
                     boat->setRoomBounds(_roomBounds);
                     float x, y;
@@ -682,9 +714,7 @@ void KuiLongBoss::startChengSanShen()
                         this->reportBoatAbsorb(amount);
                     });
 
-                    auto scene = Director::getInstance()->getRunningScene();
-                    auto gs = dynamic_cast<GameScene*>(scene);
-                    if (gs) gs->addEnemy(boat);
+                    gs->addEnemy(boat);
                     _summonedBoat = boat;
                 }
             }
@@ -699,6 +729,13 @@ void KuiLongBoss::startChengSanShen()
 void KuiLongBoss::updateChengSanShen(float dt)
 {
     _chengSanShenTimer += dt;
+
+    // Boat 死亡后会回收到预留池并可能被再次取出，不能继续持有
+    if (_summonedBoat && _summonedBoat->getState() == EntityState::DIE)
+    {
+        _summonedBoat = nullptr;
+    }
+
     if (!_chengSanShenEnding && _chengSanShenTimer >= _chengSanShenDuration)
     {
         endChengSanShen();
@@ -768,7 +805,7 @@ void KuiLongBoss::startChengWuJie(Player* target)
     if (wind) _sprite->stopAction(wind);
     auto prevHit = _sprite->getActionByTag(KUI_LONG_HIT_TAG);
     if (prevHit) _sprite->stopAction(prevHit);
-    this->stopActionByTag(KUI_LONG_WINDUP_TAG);
+    cancelTimer(_windupTimer);
     _sprite->stopActionByTag(KUI_LONG_CHANGE_TAG);
 
     if (_animBChengWuJie) {
@@ -778,66 +815,50 @@ void KuiLongBoss::startChengWuJie(Player* target)
         _sprite->runAction(animate);
     }
 
-    this->stopActionByTag(KUI_LONG_SKILL_DAMAGE_TAG);
-    this->_skillDamageScheduled = false;
+    cancelTimer(_skillDamageTimer);
+    this->_skillDamageScheduled = true;
+    scheduleChengWuJieHit(target, this->_skillDamagePerHit, 0, 0.0f);
+}
 
-    int dmgPerHit = this->_skillDamagePerHit;
-    Vector<FiniteTimeAction*> acts;
-    
-    auto createHitFunc = [this, target, dmgPerHit]() {
-        return CallFunc::create([this, target, dmgPerHit]() {
-            if (!target) return;
-            if (this->_currentState == EntityState::DIE) return;
-            float distSqr = (target->getPosition() - this->getPosition()).lengthSquared();
-            if (distSqr <= (this->_skillRange * this->_skillRange)) {
-                target->takeDamage(dmgPerHit);
-            }
-            
-            Scene* running = Director::getInstance()->getRunningScene();
-            if (running) {
-                std::vector<NiLuFire*> found;
-                collectNiLuFiresRecursive(running, found);
-                for (auto fire : found) {
-                    if (!fire) continue;
-                    if (!_roomBounds.equals(Rect::ZERO)) {
-                        if (!_roomBounds.containsPoint(fire->getPosition())) continue;
-                    }
-                    fire->performAttackImmediate(this->getAttack());
-                }
-            }
-        });
-    };
+void KuiLongBoss::scheduleChengWuJieHit(Player* target, int dmgPerHit, int hitIndex, float delay)
+{
+    _skillDamageTimer = scheduleTimer(delay, [this, target, dmgPerHit, hitIndex]() {
+        this->applyChengWuJieHit(target, dmgPerHit);
+
+        if (hitIndex + 1 < CHENG_WU_JIE_HIT_COUNT) {
+            this->scheduleChengWuJieHit(target, dmgPerHit, hitIndex + 1, CHENG_WU_JIE_HIT_GAPS[hitIndex]);
+            return;
+        }
 
-    acts.pushBack(createHitFunc());
-    acts.pushBack(DelayTime::create(0.5f));
-    acts.pushBack(createHitFunc());
-    acts.pushBack(DelayTime::create(0.5f));
-    acts.pushBack(createHitFunc());
-    acts.pushBack(DelayTime::create(0.5f));
-    acts.pushBack(createHitFunc());
-    acts.pushBack(DelayTime::create(1.0f));
-    acts.pushBack(createHitFunc());
-
-    acts.pushBack(CallFunc::create([this]() {
+        // 最后一击后结束技能
         this->_skillDamageScheduled = false;
         this->_skillPlaying = false;
         if (this->_currentState != EntityState::DIE) {
             this->setState(EntityState::IDLE);
         }
-    }));
+    });
+}
 
-    FiniteTimeAction* seqHead = nullptr;
-    if (!acts.empty()) {
-        seqHead = acts.at(0);
-        for (ssize_t i = 1; i < static_cast<ssize_t>(acts.size()); ++i) {
-            seqHead = Sequence::create(seqHead, acts.at(i), nullptr);
-        }
+void KuiLongBoss::applyChengWuJieHit(Player* target, int dmgPerHit)
+{
+    if (!target) return;
+    if (this->_currentState == EntityState::DIE) return;
+    float distSqr = (target->getPosition() - this->getPosition()).lengthSquared();
+    if (distSqr <= (this->_skillRange * this->_skillRange)) {
+        DamageQueue::getInstance()->push(target, dmgPerHit, Color3B(220,20,20));
     }
 
-    if (seqHead) {
-        seqHead->setTag(KUI_LONG_SKILL_DAMAGE_TAG);
-        this->_skillDamageScheduled = true;
-        this->runAction(dynamic_cast<Action*>(seqHead));
+    Scene* running = Director::getInstance()->getRunningScene();
+    if (running) {
+        std::vector<NiLuFire*> found;
+        collectNiLuFiresRecursive(running, found);
+        for (auto fire : found) {
+            if (!fire) continue;
+            if (!_roomBounds.equals(Rect::ZERO)) {
+                if (!_roomBounds.containsPoint(fire->getPosition())) continue;
+            }
+            fire->performAttackImmediate(this->getAttack());
+        }
     }
 }
 
@@ -850,12 +871,16 @@ void KuiLongBoss::die()
         return;
     }
 
+    // 死亡动画播放完毕、Boss 被移除时才算 Boss 房间清空（onExit 释放挂起）
+    holdRoomClear();
     setState(EntityState::DIE);
     this->removeStealthSource((void*)this);
 
     if (_phase == PHASE_C || _phase == PHASE_C_IDLE)
     {
+        // 前摇与承无解分段伤害是 TimerWheel 计时器，stopAllActions 不会取消
         stopAllActions();
+        cancelAllTimers();
         if (_sprite) _sprite->stopAllActions();
 
         // 清理场上其他敌人
@@ -864,12 +889,12 @@ void KuiLongBoss::die()
             Vector<Node*> toRemove;
             for (auto child : parent->getChildren()) {
                 if (child == this) continue;
-                if (dynamic_cast<Enemy*>(child)) {
+                if (Enemy::asEnemy(child)) {
                     toRemove.pushBack(child);
                 }
             }
             for (auto node : toRemove) {
-                auto e = dynamic_cast<Enemy*>(node);
+                auto e = Enemy::asEnemy(node);
                 if (e) e->setState(EntityState::DIE);
                 node->removeFromParentAndCleanup(true);
             }
@@ -882,10 +907,10 @@ void KuiLongBoss::die()
             auto scene = Director::getInstance()->getRunningScene();
             auto gs = dynamic_cast<GameScene*>(scene);
             
-            // 先从父节点移除
+            // 先从父节点移除（释放清房挂起，Boss 房间清空后由 GameScene 显示胜利）
             this->removeFromParentAndCleanup(true);
             
-            // 直接调用 showVictory
+            // 兜底：Boss 未登记到房间时直接显示胜利（showVictory 可重复调用）
             if (gs) {
                 gs->showVictory();
             }
@@ -973,16 +998,16 @@ KuiLongBoss::~KuiLongBoss()
     if (_sprite) _sprite->stopAllActions();
     this->removeStealthSource((void*)this);
 
-    if (_animAIdle)        { _animAIdle->release();        _animAIdle = nullptr; }
-    if (_animAChangeToB)   { _animAChangeToB->release();   _animAChangeToB = nullptr; }
-    if (_animBMove)        { _animBMove->release();        _animBMove = nullptr; }
-    if (_animBAttack)      { _animBAttack->release();      _animBAttack = nullptr; }
-    if (_animBChangeToC)   { _animBChangeToC->release();   _animBChangeToC = nullptr; }
-    if (_animBChengWuJie)  { _animBChengWuJie->release();  _animBChengWuJie = nullptr; }
-    if (_animCSS_Start)    { _animCSS_Start->release();    _animCSS_Start = nullptr; }
-    if (_animCSS_Idle)     { _animCSS_Idle->release();     _animCSS_Idle = nullptr; }
-    if (_animCSS_End)      { _animCSS_End->release();      _animCSS_End = nullptr; }
-    if (_animCDie)         { _animCDie->release();         _animCDie = nullptr; }
+    if (_animAIdle)        { LEAK_TRACK_RELEASE(_animAIdle);       _animAIdle->release();       _animAIdle = nullptr; }
+    if (_animAChangeToB)   { LEAK_TRACK_RELEASE(_animAChangeToB);  _animAChangeToB->release();  _animAChangeToB = nullptr; }
+    if (_animBMove)        { LEAK_TRACK_RELEASE(_animBMove);       _animBMove->release();       _animBMove = nullptr; }
+    if (_animBAttack)      { LEAK_TRACK_RELEASE(_animBAttack);     _animBAttack->release();     _animBAttack = nullptr; }
+    if (_animBChangeToC)   { LEAK_TRACK_RELEASE(_animBChangeToC);  _animBChangeToC->release();  _animBChangeToC = nullptr; }
+    if (_animBChengWuJie)  { LEAK_TRACK_RELEASE(_animBChengWuJie); _animBChengWuJie->release(); _animBChengWuJie = nullptr; }
+    if (_animCSS_Start)    { LEAK_TRACK_RELEASE(_animCSS_Start);   _animCSS_Start->release();   _animCSS_Start = nullptr; }
+    if (_animCSS_Idle)     { LEAK_TRACK_RELEASE(_animCSS_Idle);    _animCSS_Idle->release();    _animCSS_Idle = nullptr; }
+    if (_animCSS_End)      { LEAK_TRACK_RELEASE(_animCSS_End);     _animCSS_End->release();     _animCSS_End = nullptr; }
+    if (_animCDie)         { LEAK_TRACK_RELEASE(_animCDie);        _animCDie->release();        _animCDie = nullptr; }
 
     if (_bossHPBar)    { _bossHPBar->removeFromParentAndCleanup(true); _bossHPBar = nullptr; }
     if (_bossHPLabel)  { _bossHPLabel->removeFromParentAndCleanup(true); _bossHPLabel = nullptr; }
@@ -1029,18 +1054,18 @@ void KuiLongBoss::spawnPhaseBMinions(bool isPeriodic)
 {
     _phaseBSummonCount++;
 
-    // 2. 奎隆二阶段开始召唤敌人：8个得意，2个新硎，3个堂皇，4个妒
-    spawnEnemyHelper("DeYi", 8, 600.0f);
-    spawnEnemyHelper("XinXing", 2, 600.0f);
-    spawnEnemyHelper("TangHuang", 3, 600.0f);
-    spawnEnemyHelper("Du", 4, 600.0f);
+    // 2. 奎隆二阶段开始召唤敌人（见 PHASE_B_WAVE）
+    for (const auto& wave : PHASE_B_WAVE)
+    {
+        spawnEnemyHelper(wave.kind, wave.count, MINION_SPAWN_RADIUS);
+    }
 
     // 3. 奎隆在第二次召唤敌人开始，每次会召唤一个托生莲座
     if (_phaseBSummonCount >= 2) {
         auto scene = Director::getInstance()->getRunningScene();
         auto gs = dynamic_cast<GameScene*>(scene);
         if (gs && !_roomBounds.equals(Rect::ZERO)) {
-            auto boat = Boat::create();
+            auto boat = static_cast<Boat*>(gs->acquireEnemy(EnemyKind::BOAT));
             if (boat) {
                 boat->setRoomBounds(_roomBounds);
                 float x, y;
@@ -1067,26 +1092,20 @@ void KuiLongBoss::spawnPhaseBMinions(bool isPeriodic)
 // 2.3: 承三身召唤逻辑 (保持原样或根据需要调整，这里暂不修改)
 void KuiLongBoss::spawnChengSanShenMinions()
 {
-    spawnEnemyHelper("DeYi", 8, 600.0f);
-    spawnEnemyHelper("Du", 4, 600.0f);
-    spawnEnemyHelper("XinXing", 4, 600.0f);
-    spawnEnemyHelper("TangHuang", 2, 600.0f);
+    for (const auto& wave : CHENG_SAN_SHEN_WAVE)
+    {
+        spawnEnemyHelper(wave.kind, wave.count, MINION_SPAWN_RADIUS);
+    }
 }
 
-void KuiLongBoss::spawnEnemyHelper(const std::string& type, int count, float radius)
+void KuiLongBoss::spawnEnemyHelper(EnemyKind kind, int count, float radius)
 {
     auto scene = Director::getInstance()->getRunningScene();
     auto gs = dynamic_cast<GameScene*>(scene);
     if (!gs) return;
 
     for (int i = 0; i < count; ++i) {
-        Enemy* enemy = nullptr;
-        if (type == "Du") enemy = Du::create();
-        else if (type == "Ayao") enemy = Ayao::create();
-        else if (type == "Cup") enemy = Cup::create();
-        else if (type == "TangHuang") enemy = TangHuang::create();
-        else if (type == "DeYi") enemy = DeYi::create();
-        else if (type == "XinXing") enemy = XinXing::create();
+        Enemy* enemy = gs->acquireEnemy(kind);
 
         if (enemy) {
             float angle = CCRANDOM_0_1() * M_PI * 2;
@@ -1114,8 +1133,9 @@ void KuiLongBoss::startTransitionBToC()
     
     _phase = TRANSITION_B_TO_C;
     
-    // 停止所有动作和技能
+    // 停止所有动作、延迟回调和技能
     stopAllActions();
+    cancelAllTimers();
     if (_sprite) _sprite->stopAllActions();
     _moveAnimPlaying = false;
     _skillPlaying = false;
@@ -1127,13 +1147,13 @@ void KuiLongBoss::startTransitionBToC()
         Vector<Node*> toRemove;
         for (auto child : parent->getChildren()) {
             if (child == this) continue;
-            if (dynamic_cast<Player*>(child)) continue;
-            if (dynamic_cast<Enemy*>(child)) {
+            if (child->getTag() == Constants::Tag::PLAYER) continue;
+            if (Enemy::asEnemy(child)) {
                 toRemove.pushBack(child);
             }
         }
         for (auto node : toRemove) {
-            auto e = dynamic_cast<Enemy*>(node);
+            auto e = Enemy::asEnemy(node);
             if (e) e->setState(EntityState::DIE);
             node->removeFromParentAndCleanup(true);
         }
@@ -1193,14 +1213,14 @@ void KuiLongBoss::forceKillAllAndTransition()
         Vector<Node*> toRemove;
         for (auto child : parent->getChildren()) {
             if (child == this) continue;
-            if (dynamic_cast<Player*>(child)) continue;
-            if (dynamic_cast<Enemy*>(child)) {
+            if (child->getTag() == Constants::Tag::PLAYER) continue;
+            if (Enemy::asEnemy(child)) {
                 toRemove.pushBack(child);
             }
         }
         for (auto node : toRemove) {
             node->removeFromParentAndCleanup(true);
-            auto e = dynamic_cast<Enemy*>(node);
+            auto e = Enemy::asEnemy(node);
             if (e) e->setState(EntityState::DIE);
         }
     }
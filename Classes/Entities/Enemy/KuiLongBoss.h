@@ -19,6 +19,12 @@ public:
 
     CREATE_FUNC(KuiLongBoss);
 
+    // 把各阶段召唤的小怪数量登记到敌人预留池（Boss 层加载时调用）
+    static void reserveMinions(class EnemyPool& pool);
+
+    // 各阶段可能召唤的种类（小怪波次、托生莲座、尼卢火），用于生成关卡资源清单
+    static void collectSummonKinds(std::vector<EnemyKind>& out);
+
     // AI 行为
     virtual void executeAI(Player* player, float dt) override;
     virtual void attack() override;
@@ -32,7 +38,6 @@ public:
     virtual int takeDamageReported(int damage) override;
     virtual void die() override;
 
-    virtual bool canSpawnKongKaZiOnDeath() const override { return false; }
     virtual bool isPoisonable() const override;
     virtual void setRoomBounds(const cocos2d::Rect& bounds) override;
     
@@ -92,7 +97,7 @@ protected:
     // 新增辅助函数
     void spawnPhaseBMinions(bool isPeriodic);
     void spawnChengSanShenMinions();
-    void spawnEnemyHelper(const std::string& type, int count, float radius);
+    void spawnEnemyHelper(EnemyKind kind, int count, float radius);
     void startTransitionBToC(); // 开始二转三流程
     void forceKillAllAndTransition(); // 2.4: 强制击杀并转阶段
 
@@ -117,7 +122,6 @@ protected:
     static const int KUI_LONG_CHANGE_TAG = 0x7F04;
     static const int KUI_LONG_DIE_TAG = 0x7F05;
     static const int KUI_LONG_SKILL_TAG = 0x7F06;
-    static const int KUI_LONG_SKILL_DAMAGE_TAG = 0x7F07;
     static const int KUI_LONG_CSS_TAG = 0x7F08;
 
     bool _moveAnimPlaying;
@@ -136,9 +140,16 @@ protected:
     cocos2d::Sprite* _skillSprite;
     bool  _skillDamageScheduled;
 
+    // 延迟回调句柄（普攻风箱、承无解逐段伤害），替代节点上的动作 tag
+    TimerWheel::Handle _windupTimer;
+    TimerWheel::Handle _skillDamageTimer;
+
     bool canUseChengWuJie() const;
     void startChengWuJie(Player* target);
     void resetChengWuJieCooldown();
+    // 承无解：逐段伤害（段数与间隔见 CHENG_WU_JIE_HIT_GAPS），每段结束后安排下一段，最后一段结束技能
+    void scheduleChengWuJieHit(Player* target, int dmgPerHit, int hitIndex, float delay);
+    void applyChengWuJieHit(Player* target, int dmgPerHit);
 
     // NiLuFire 相关 
     cocos2d::Rect _roomBounds;
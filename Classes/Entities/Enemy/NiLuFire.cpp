@@ -4,6 +4,7 @@
 #include "cocos2d.h"
 #include "Entities/Player/Player.h"
 #include "UI/FloatingText.h"
+#include "Entities/Base/DamageQueue.h"
 #include "Scenes/GameScene.h"
 #include "Core/Constants.h" // 用于 ZOrder
 
@@ -29,9 +30,7 @@ static void showDebugCross(cocos2d::Node* attachTarget, const cocos2d::Vec2& wor
     dn->drawSolidRect(v1, v2, color);
     dn->drawSolidRect(h1, h2, color);
 
-    float z = static_cast<float>(Constants::ZOrder::FLOOR + 6);
-    dn->setGlobalZOrder(z);
-    attachTarget->addChild(dn, 1000);
+    attachTarget->addChild(dn, Constants::ZOrder::FLOOR + 6);
 
     auto seq = Sequence::create(DelayTime::create(duration), RemoveSelf::create(), nullptr);
     dn->runAction(seq);
@@ -39,7 +38,8 @@ static void showDebugCross(cocos2d::Node* attachTarget, const cocos2d::Vec2& wor
 }
 
 NiLuFire::NiLuFire()
-    : _animAttack(nullptr)
+    : Enemy(EnemyKind::NILU_FIRE)
+    , _animAttack(nullptr)
     , _animBurn(nullptr)
     , _hpBar(nullptr)
     , _hpLabel(nullptr)
@@ -68,10 +68,7 @@ bool NiLuFire::init()
 {
     if (!Enemy::init()) return false;
 
-    setEnemyType(EnemyType::MELEE);
-    setMaxHP(2000);    // 修改：血量上限设为 2000
     setHP(0);          // 初始血量为 0（如设计要求）
-    setMoveSpeed(0.0f);
     setAttack(0);      // 物理攻击值不用于 NiLu，使用 performAttackImmediate 的参数
     setSightRange(300.0f);
     setAttackRange(120.0f);
@@ -177,9 +174,6 @@ void NiLuFire::createHPBar()
     // 为了确保 world-space 的可见性，直接作为 NiLuFire 的子节点，但设置 global z-order 到地板之上
     float barWidth = 48.0f;
     float barHeight = 6.0f;
-    float bgGlobalZ = static_cast<float>(Constants::ZOrder::FLOOR + 1);
-    float fillGlobalZ = static_cast<float>(Constants::ZOrder::FLOOR + 2);
-    float labelGlobalZ = static_cast<float>(Constants::ZOrder::FLOOR + 3);
 
     // 使用 LoadingBar 做填充
     _hpBar = ui::LoadingBar::create("UIs/StatusBars/Bars/HealthFill.png");
@@ -191,7 +185,6 @@ void NiLuFire::createHPBar()
         // 向上移动一些（靠近精灵）: 原先 -6，现在改为 -2，让血条更靠近精灵
         _hpBar->setPosition(Vec2(0.0f, -(_sprite ? _sprite->getBoundingBox().size.height * 0.5f : 12.0f) - 2.0f));
         _hpBar->setColor(Color3B(64, 128, 255)); // 蓝色血条
-        _hpBar->setGlobalZOrder(fillGlobalZ);
         this->addChild(_hpBar, 1);
     }
 
@@ -204,7 +197,6 @@ void NiLuFire::createHPBar()
         _hpLabel->setTextColor(Color4B::WHITE);
         // 标签也上移一点（原 -14 -> -10）
         _hpLabel->setPosition(Vec2(0.0f, -(_sprite ? _sprite->getBoundingBox().size.height * 0.5f : 12.0f) - 10.0f));
-        _hpLabel->setGlobalZOrder(labelGlobalZ);
         this->addChild(_hpLabel, 2);
     }
 }
@@ -350,9 +342,7 @@ void NiLuFire::performAttackImmediate(int damage)
 
     if (_sprite) atkSprite->setScale(_sprite->getScale());
 
-    float atkGlobalZ = static_cast<float>(Constants::ZOrder::FLOOR + 4);
-    atkSprite->setGlobalZOrder(atkGlobalZ);
-    attachTarget->addChild(atkSprite, 10);
+    attachTarget->addChild(atkSprite, Constants::ZOrder::FLOOR + 4);
 
     // debug 可视化与日志
     float animDuration = _animAttack->getDelayPerUnit() * static_cast<float>(_animAttack->getFrames().size());
@@ -384,14 +374,8 @@ void NiLuFire::performAttackImmediate(int damage)
 
                     if (hit && usedDamage > 0)
                     {
-                        player->takeDamage(usedDamage);
-
-                        // 显示浅蓝绿色浮动数字以便区分尼卢火伤害
-                        Node* parentForText = player->getParent() ? player->getParent() : running;
-                        if (parentForText)
-                        {
-                            FloatingText::show(parentForText, player->getPosition(), std::to_string(usedDamage), Color3B(100,220,180));
-                        }
+                        // 浅蓝绿色浮字以便区分尼卢火伤害
+                        DamageQueue::getInstance()->push(player, usedDamage, Color3B(100,220,180));
                     }
                 }
             }
@@ -443,12 +427,8 @@ void NiLuFire::performSelfDestruct()
 
                             if (hit && dmg > 0)
                             {
-                                player->takeDamage(dmg);
-                                Node* parentForText = player->getParent() ? player->getParent() : running;
-                                if (parentForText)
-                                {
-                                    FloatingText::show(parentForText, player->getPosition(), std::to_string(dmg), Color3B(100,220,180));
-                                }
+                                // 浅蓝绿色浮字以便区分尼卢火伤害
+                                DamageQueue::getInstance()->push(player, dmg, Color3B(100,220,180));
                             }
                         }
                     }
@@ -473,9 +453,7 @@ void NiLuFire::performSelfDestruct()
             Vec2 targetPosInAttach = attachTarget->convertToNodeSpace(worldPos);
             atkSprite->setPosition(targetPosInAttach);
             if (_sprite) atkSprite->setScale(_sprite->getScale());
-            float atkGlobalZ = static_cast<float>(Constants::ZOrder::FLOOR + 4);
-            atkSprite->setGlobalZOrder(atkGlobalZ);
-            attachTarget->addChild(atkSprite, 10);
+            attachTarget->addChild(atkSprite, Constants::ZOrder::FLOOR + 4);
 
             float animDuration = _animAttack->getDelayPerUnit() * static_cast<float>(_animAttack->getFrames().size());
             showDebugCross(attachTarget, worldPos, 100.0f, 20.0f, std::max(0.2f, animDuration));
@@ -500,12 +478,8 @@ void NiLuFire::performSelfDestruct()
 
                             if (hit && dmg > 0)
                             {
-                                player->takeDamage(dmg);
-                                Node* parentForText = player->getParent() ? player->getParent() : running;
-                                if (parentForText)
-                                {
-                                    FloatingText::show(parentForText, player->getPosition(), std::to_string(dmg), Color3B(100,220,180));
-                                }
+                                // 浅蓝绿色浮字以便区分尼卢火伤害
+                                DamageQueue::getInstance()->push(player, dmg, Color3B(100,220,180));
                             }
                         }
                     }
@@ -544,12 +518,8 @@ void NiLuFire::performSelfDestruct()
 
                 if (hit && dmg > 0)
                 {
-                    player->takeDamage(dmg);
-                    Node* parentForText = player->getParent() ? player->getParent() : running;
-                    if (parentForText)
-                    {
-                        FloatingText::show(parentForText, player->getPosition(), std::to_string(dmg), Color3B(100,220,180));
-                    }
+                    // 浅蓝绿色浮字以便区分尼卢火伤害
+                    DamageQueue::getInstance()->push(player, dmg, Color3B(100,220,180));
                 }
             }
         }
@@ -27,12 +27,6 @@ public:
     // NiLuFire 不应被我方普通攻击伤害（由此覆盖）
     virtual void takeDamage(int damage) override;
 
-    // NiLuFire 不计入房间清怪统计（覆盖）
-    virtual bool countsForRoomClear() const override { return false; }
-
-    // 禁止被恐卡兹标记/寄生（覆盖）
-    virtual bool canSpawnKongKaZiOnDeath() const override { return false; }
-
     // 查询当前是否处于“正在播放攻击动画/将要造成伤害”的状态
     bool isPerformingAttack() const { return _isPerformingAttack; }
 
@@ -3,6 +3,9 @@
 #include "Entities/Player/Player.h"
 #include "Entities/Enemy/IronLightCup.h"
 #include "Scenes/GameScene.h"
+#include "Utils/VfxShapes.h"
+#include "Entities/Base/DamageQueue.h"
+#include <memory>
 
 USING_NS_CC;
 
@@ -15,7 +18,8 @@ static constexpr float TANGHUANG_SMOKE_DURATION = 5.0f; // 持续 5s
 static constexpr float TANGHUANG_SMOKE_RADIUS = 250.0f; // 半径 150
 
 TangHuang::TangHuang()
-    : _moveAnimation(nullptr)
+    : Enemy(EnemyKind::TANGHUANG)
+    , _moveAnimation(nullptr)
     , _attackAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _skillAnimation(nullptr)
@@ -39,8 +43,6 @@ bool TangHuang::init()
 {
     if (!Enemy::init()) return false;
 
-    setEnemyType(EnemyType::MELEE);
-
     setupAttributes();
     loadAnimations();
 
@@ -63,12 +65,8 @@ bool TangHuang::init()
 
 void TangHuang::setupAttributes()
 {
-    // 默认属性（可根据游戏平衡调整）
-    setMaxHP(5000);
-    setHP(5000);
-
+    // 默认属性（可根据游戏平衡调整，血量与移速见 EnemyKinds::TABLE）
     setAttack(750);
-    setMoveSpeed(70.0f);
 
     setSightRange(200.0f);
     setAttackRange(40.0f);
@@ -319,8 +317,7 @@ void TangHuang::attack()
         float windup = this->getAttackWindup();
         // 捕获当前目标指针，在 windup 完成时执行实际伤害
         Player* target = _attackTarget;
-        auto delay = DelayTime::create(windup);
-        auto callback = CallFunc::create([this, target]() {
+        scheduleTimer(windup, [this, target]() {
             if (_currentState == EntityState::ATTACK)
             {
                 // 触发实际伤害判定
@@ -331,16 +328,13 @@ void TangHuang::attack()
                 setState(EntityState::IDLE);
             }
         });
-        auto seq = Sequence::create(delay, callback, nullptr);
-        this->runAction(seq);
     }
     else
     {
         // 无动画时仅按 windup 恢复状态并造成伤害
         float windup = this->getAttackWindup();
         Player* target = _attackTarget;
-        auto delay = DelayTime::create(windup);
-        auto cb = CallFunc::create([this, target]() {
+        scheduleTimer(windup, [this, target]() {
             if (_currentState == EntityState::ATTACK)
             {
                 if (target && !target->isDead() && isPlayerInAttackRange(target))
@@ -350,7 +344,6 @@ void TangHuang::attack()
                 setState(EntityState::IDLE);
             }
         });
-        this->runAction(Sequence::create(delay, cb, nullptr));
     }
 
     GAME_LOG("TangHuang attacks!");
@@ -361,7 +354,7 @@ void TangHuang::attackPlayer(Player* player)
     if (!player) return;
 
     int dmg = this->getAttack();
-    player->takeDamage(dmg);
+    DamageQueue::getInstance()->push(player, dmg, Color3B(220, 20, 20));
 
     GAME_LOG("TangHuang dealt %d damage to player", dmg);
 
@@ -380,10 +373,9 @@ void TangHuang::useSmokeSkill()
     _skillCooldownTimer = _skillCooldown;
 
     // 延迟实际释放（0.5s）
-    this->runAction(Sequence::create(DelayTime::create(TANGHUANG_SMOKE_DELAY),
-        CallFunc::create([this]() {
-            this->spawnSmoke();
-        }), nullptr));
+    scheduleTimer(TANGHUANG_SMOKE_DELAY, [this]() {
+        this->spawnSmoke();
+    });
 }
 
 void TangHuang::spawnSmoke()
@@ -397,10 +389,10 @@ void TangHuang::spawnSmoke()
         _sprite->runAction(animate);
     }
 
-    // 创建烟雾 DrawNode（视觉）并放在地板之上（而非角色下方）
-    auto smoke = DrawNode::create();
+    // 创建烟雾圆盘（共享缓存的圆形纹理，不再每次细分几何）并放在地板之上（而非角色下方）
     Color4F smokeColor(0.85f, 0.85f, 0.85f, 0.6f); // 浅灰白，半透明
-    smoke->drawSolidCircle(Vec2::ZERO, TANGHUANG_SMOKE_RADIUS, 0, 64, smokeColor);
+    auto smoke = VfxShapes::createDisc(TANGHUANG_SMOKE_RADIUS, smokeColor);
+    if (!smoke) return;
 
     // 将烟雾添加到与角色相同的父节点（通常为 gameLayer），并设置在地板之上
     Node* parent = this->getParent();
@@ -409,7 +401,6 @@ void TangHuang::spawnSmoke()
         int smokeZ = Constants::ZOrder::FLOOR + 1; // 放在地板之上
         parent->addChild(smoke, smokeZ);
         smoke->setPosition(this->getPosition());
-        smoke->setGlobalZOrder(static_cast<float>(smokeZ));
     }
     else
     {
@@ -418,8 +409,8 @@ void TangHuang::spawnSmoke()
         smoke->setPosition(Vec2::ZERO);
     }
 
-    // 用一个堆上分配的容器记录当前圆内的敌人（用于差分 add/remove）
-    auto insideVec = new std::vector<Enemy*>();
+    // 记录当前圆内的敌人（用于差分 add/remove），由两个回调共享；烟雾提前销毁时随回调一起释放
+    auto insideVec = std::make_shared<std::vector<Enemy*>>();
 
     // 每帧更新：检查父节点（通常为 gameLayer）下的敌人，添加/移除 stealth 源
     smoke->schedule([this, smoke, insideVec](float dt) {
@@ -437,7 +428,7 @@ void TangHuang::spawnSmoke()
         {
             if (child && child->getTag() == Constants::Tag::ENEMY)
             {
-                auto e = dynamic_cast<Enemy*>(child);
+                auto e = Enemy::asEnemy(child);
                 if (!e) continue;
                 if (e->isDead()) continue;
                 float dist = e->getPosition().distance(this->getPosition());
@@ -472,27 +463,28 @@ void TangHuang::spawnSmoke()
     }, "TangHuangSmokeUpdate");
 
     // After duration, unschedule update, remove stealth from remaining inside, and remove node
-    smoke->runAction(Sequence::create(DelayTime::create(TANGHUANG_SMOKE_DURATION),
-        CallFunc::create([smoke, insideVec]() {
-            // 停止调度
-            smoke->unschedule("TangHuangSmokeUpdate");
-
-            // 移除残留的 stealth 源
-            for (auto e : *insideVec)
-            {
-                if (e) e->removeStealthSource((void*)smoke);
-            }
+    // 烟雾可能比堂皇存活更久，计时器挂在场景上（离开场景时随场景取消）；找不到 GameScene 时挂在堂皇上
+    auto gs = dynamic_cast<GameScene*>(Director::getInstance()->getRunningScene());
+    TimerWheel::Owner* owner = gs ? gs->getTimerOwner() : &_timerOwner;
+    TimerWheel::getInstance()->schedule(TANGHUANG_SMOKE_DURATION, owner, [smoke, insideVec]() {
+        // 停止调度
+        smoke->unschedule("TangHuangSmokeUpdate");
+
+        // 移除残留的 stealth 源
+        for (auto e : *insideVec)
+        {
+            if (e) e->removeStealthSource((void*)smoke);
+        }
 
-            // 清理容器
-            delete insideVec;
+        insideVec->clear();
 
-            // 淡出并移除烟雾节点
-            auto fade = FadeOut::create(0.35f);
-            auto remove = CallFunc::create([smoke]() {
-                if (smoke->getParent()) smoke->removeFromParent();
-            });
-            smoke->runAction(Sequence::create(fade, remove, nullptr));
-        }), nullptr));
+        // 淡出并移除烟雾节点
+        auto fade = FadeOut::create(0.35f);
+        auto remove = CallFunc::create([smoke]() {
+            if (smoke->getParent()) smoke->removeFromParent();
+        });
+        smoke->runAction(Sequence::create(fade, remove, nullptr));
+    });
 }
 
 void TangHuang::playAttackAnimation()
@@ -514,30 +506,19 @@ void TangHuang::die()
 
     // 防重入：设置死亡状态
     if (_currentState == EntityState::DIE && !_isAlive) return;
+    // 死亡动画结束后才会生成后续敌人，期间挂起房间清空判定（移除自身时释放）
+    holdRoomClear();
     setState(EntityState::DIE);
     _isAlive = false;
 
     // 停止其他动作并播放死亡动画，播放完成后生成 1 个 IronLightCup（与 XinXing 的实现一致）
     this->stopAllActions();
+    cancelAllTimers();   // 烟雾技能的延迟释放
     if (_sprite) { _sprite->stopAllActions(); _sprite->setVisible(true); _sprite->setOpacity(255); }
 
     auto finalizeSpawn = [this]() {
         Vec2 basePos = this->getPosition();
 
-        // 创建并放置 1 个 IronLightCup，位置在堂皇原地稍微偏移随机一点
-        auto il = IronLightCup::create();
-        if (!il) {
-            this->removeFromParent();
-            return;
-        }
-
-        float angle = CCRANDOM_MINUS1_1() * M_PI;
-        float r = 12.0f;
-        Vec2 spawnPos = basePos + Vec2(std::cos(angle) * r, std::sin(angle) * r);
-        il->setPosition(spawnPos);
-
-        if (_hasRoomBounds) il->setRoomBounds(_roomBounds);
-
         // 尝试通过当前运行场景注册到 GameScene，以便被 update/enemies 管理（与 XinXing 中的逻辑完全一致）
         Scene* running = Director::getInstance()->getRunningScene();
         GameScene* gs = nullptr;
@@ -553,8 +534,23 @@ void TangHuang::die()
                 }
             }
         }
-        if (gs) gs->addEnemy(il);
-        else if (running) running->addChild(il);
+
+        // 创建并放置 IronLightCup（优先从 GameScene 的预留池取出），位置在堂皇原地稍微偏移随机一点
+        for (int i = 0; i < IRON_LIGHT_CUP_COUNT; ++i)
+        {
+            Enemy* il = gs ? gs->acquireEnemy(EnemyKind::IRON_LIGHT_CUP) : IronLightCup::create();
+            if (!il) continue;
+
+            float angle = CCRANDOM_MINUS1_1() * M_PI;
+            float r = 12.0f;
+            Vec2 spawnPos = basePos + Vec2(std::cos(angle) * r, std::sin(angle) * r);
+            il->setPosition(spawnPos);
+
+            if (_hasRoomBounds) il->setRoomBounds(_roomBounds);
+
+            if (gs) gs->addEnemy(il);
+            else if (running) running->addChild(il);
+        }
 
         // 移除自身（与 XinXing 保持相同的移除调用风格）
         this->removeFromParent();
@@ -571,4 +567,20 @@ void TangHuang::die()
 
     // 没有死亡动画则直接生成并移除
     finalizeSpawn();
+}
+
+void TangHuang::reset()
+{
+    Enemy::reset();
+
+    _attackTarget = nullptr;
+    _skillCooldownTimer = 0.0f;
+    _roomBounds = Rect::ZERO;
+    _hasRoomBounds = false;
+
+    // 死亡动画停在最后一帧，恢复为移动动画第一帧
+    if (_sprite && _moveAnimation && !_moveAnimation->getFrames().empty())
+    {
+        _sprite->setSpriteFrame(_moveAnimation->getFrames().front()->getSpriteFrame());
+    }
 }
\ No newline at end of file
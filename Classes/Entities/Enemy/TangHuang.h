@@ -22,6 +22,9 @@ public:
 
     CREATE_FUNC(TangHuang);
 
+    // 死亡动画结束后生成的铁光杯数量
+    static const int IRON_LIGHT_CUP_COUNT = 1;
+
     // AI 循环
     virtual void executeAI(Player* player, float dt) override;
 
@@ -33,6 +36,7 @@ public:
     virtual void attack() override;
     virtual void playAttackAnimation() override;
     virtual void die() override;
+    virtual void reset() override;
 
     // 设置房间边界
     virtual void setRoomBounds(const cocos2d::Rect& bounds) override { _roomBounds = bounds; _hasRoomBounds = true; }
@@ -11,15 +11,15 @@ USING_NS_CC;
 static const int XINX_MOVE_ACTION_TAG    = 0xE101;
 static const int XINX_HIT_ACTION_TAG     = 0xE102;
 static const int XINX_WINDUP_ACTION_TAG  = 0xE103;
-// 节点层面的风箱回退（与 sprite 上的 windup 区分）
-static const int XINX_WINDUP_NODE_TAG   = 0xE104;
 
 XinXing::XinXing()
-    : _moveAnimation(nullptr)
+    : Enemy(EnemyKind::XINXING)
+    , _moveAnimation(nullptr)
     , _attackAnimation(nullptr)
     , _dieAnimation(nullptr)
     , _roomBounds(Rect::ZERO)
     , _hasRoomBounds(false)
+    , _windupTimer(TimerWheel::INVALID_HANDLE)
 {
 }
 
@@ -35,8 +35,6 @@ bool XinXing::init()
     if (!Enemy::init())
         return false;
 
-    setEnemyType(EnemyType::MELEE);
-
     setupAttributes();
     loadAnimations();
 
@@ -72,10 +70,7 @@ bool XinXing::init()
 void XinXing::setupAttributes()
 {
     // 基础属性（可按需微调）
-    setMaxHP(6000);
-    setHP(6000);
     setAttack(2000);            // 高伤害
-    setMoveSpeed(120.0f);
 
     setSightRange(320.0f);
     setAttackRange(50.0f);
@@ -204,16 +199,14 @@ void XinXing::attack()
     setState(EntityState::ATTACK);
     resetAttackCooldown();
 
-    // 先在节点层面注册一个风箱延迟回退（确保即便 playAttackAnimation 未被调用也不会一直卡在 ATTACK）
+    // 先注册一个风箱延迟回退（确保即便 playAttackAnimation 未被调用也不会一直卡在 ATTACK）
+    // 没有动画资源时同样由它按风箱时长回退到 IDLE
     float windup = getAttackWindup();
-    // 先移除已有同 tag 的（避免重复）
-    this->stopActionByTag(XINX_WINDUP_NODE_TAG);
-    auto nodeDelay = Sequence::create(DelayTime::create(windup),
-                                      CallFunc::create([this]() {
-                                          if (_currentState == EntityState::ATTACK) setState(EntityState::IDLE);
-                                      }), nullptr);
-    nodeDelay->setTag(XINX_WINDUP_NODE_TAG);
-    this->runAction(nodeDelay);
+    // 先取消已有的回退（避免重复）
+    cancelTimer(_windupTimer);
+    _windupTimer = scheduleTimer(windup, [this]() {
+        if (_currentState == EntityState::ATTACK) setState(EntityState::IDLE);
+    });
 
     if (_attackAnimation && _sprite)
     {
@@ -231,18 +224,7 @@ void XinXing::attack()
         animate->setTag(XINX_WINDUP_ACTION_TAG);
         _sprite->runAction(animate);
 
-        // 注意：不要在这里再强制把状态置回 IDLE（节点层面的延时回退会处理逃跑场景；当 playAttackAnimation 被调用时会停止该回退）
-    }
-    else
-    {
-        // 没有动画时按风箱时长回退到 IDLE（兼容无视觉资源）
-        this->stopActionByTag(XINX_WINDUP_NODE_TAG);
-        auto fallback = Sequence::create(DelayTime::create(windup),
-                                         CallFunc::create([this]() {
-                                             if (_currentState == EntityState::ATTACK) setState(EntityState::IDLE);
-                                         }), nullptr);
-        fallback->setTag(XINX_WINDUP_NODE_TAG);
-        this->runAction(fallback);
+        // 注意：不要在这里再强制把状态置回 IDLE（风箱回退会处理逃跑场景；当 playAttackAnimation 被调用时会取消该回退）
     }
 }
 
@@ -251,8 +233,8 @@ void XinXing::playAttackAnimation()
     if (!_sprite) return;
     if (_currentState == EntityState::DIE) return;
 
-    // 如果我们即将播放命中动画，先取消节点层面的风箱回退，避免在命中动画进行中被置回 IDLE
-    this->stopActionByTag(XINX_WINDUP_NODE_TAG);
+    // 如果我们即将播放命中动画，先取消风箱回退，避免在命中动画进行中被置回 IDLE
+    cancelTimer(_windupTimer);
 
     if (_currentState != EntityState::ATTACK) setState(EntityState::ATTACK);
 
@@ -333,43 +315,48 @@ void XinXing::die()
     // 防止重复处理
     if (_currentState == EntityState::DIE && !_isAlive) return;
 
+    // 死亡动画结束后才会生成后续敌人，期间挂起房间清空判定（移除自身时释放）
+    holdRoomClear();
     setState(EntityState::DIE);
     _isAlive = false;
 
     this->stopAllActions();
+    cancelAllTimers();
     if (_sprite) { _sprite->stopAllActions(); _sprite->setVisible(true); _sprite->setOpacity(255); }
 
     // 播放死亡动画并在结束后生成 IronLance（若资源存在则用动画）
     auto finalizeSpawn = [this]() {
         Vec2 basePos = this->getPosition();
         const float PI_F = 3.14159265358979323846f;
-        for (int i = 0; i < 3; ++i)
+
+        // 注册到 GameScene，保证房间管理与边界设置一致；铁枪优先从 GameScene 的预留池取出
+        Scene* running = Director::getInstance()->getRunningScene();
+        GameScene* gs = nullptr;
+        if (running)
+        {
+            gs = dynamic_cast<GameScene*>(running);
+            if (!gs)
+            {
+                for (auto child : running->getChildren())
+                {
+                    gs = dynamic_cast<GameScene*>(child);
+                    if (gs) break;
+                }
+            }
+        }
+
+        for (int i = 0; i < IRON_LANCE_COUNT; ++i)
         {
-            auto il = IronLance::create();
+            Enemy* il = gs ? gs->acquireEnemy(EnemyKind::IRON_LANCE) : IronLance::create();
             if (!il) continue;
 
-            float angle = (static_cast<float>(i) / 3.0f) * (2.0f * PI_F);
+            float angle = (static_cast<float>(i) / IRON_LANCE_COUNT) * (2.0f * PI_F);
             float r = 24.0f + 8.0f * i;
             Vec2 spawnPos = basePos + Vec2(std::cos(angle) * r, std::sin(angle) * r);
             il->setPosition(spawnPos);
 
             if (_hasRoomBounds) il->setRoomBounds(_roomBounds);
 
-            // 注册到 GameScene，保证房间管理与边界设置一致
-            Scene* running = Director::getInstance()->getRunningScene();
-            GameScene* gs = nullptr;
-            if (running)
-            {
-                gs = dynamic_cast<GameScene*>(running);
-                if (!gs)
-                {
-                    for (auto child : running->getChildren())
-                    {
-                        gs = dynamic_cast<GameScene*>(child);
-                        if (gs) break;
-                    }
-                }
-            }
             if (gs) gs->addEnemy(il);
             else if (running) running->addChild(il);
         }
@@ -388,4 +375,19 @@ void XinXing::die()
     {
         finalizeSpawn();
     }
+}
+
+void XinXing::reset()
+{
+    Enemy::reset();
+
+    _windupTimer = TimerWheel::INVALID_HANDLE;
+    _roomBounds = Rect::ZERO;
+    _hasRoomBounds = false;
+
+    // 死亡动画停在最后一帧，恢复为移动动画第一帧
+    if (_sprite && _moveAnimation && !_moveAnimation->getFrames().empty())
+    {
+        _sprite->setSpriteFrame(_moveAnimation->getFrames().front()->getSpriteFrame());
+    }
 }
\ No newline at end of file
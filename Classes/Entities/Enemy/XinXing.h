@@ -22,6 +22,9 @@ public:
 
     CREATE_FUNC(XinXing);
 
+    // 死亡动画结束后生成的铁枪数量
+    static const int IRON_LANCE_COUNT = 3;
+
     // AI 行为（覆盖基类）
     virtual void executeAI(Player* player, float dt) override;
 
@@ -33,6 +36,7 @@ public:
     virtual void attack() override;
     virtual void playAttackAnimation() override;
     virtual void die() override;
+    virtual void reset() override;
 
     // 房间边界
     virtual void setRoomBounds(const cocos2d::Rect& bounds) override { _roomBounds = bounds; _hasRoomBounds = true; }
@@ -47,6 +51,9 @@ protected:
 
     cocos2d::Rect _roomBounds;
     bool _hasRoomBounds;
+
+    // 风箱回退计时器（与 sprite 上的 windup 动画区分）
+    TimerWheel::Handle _windupTimer;
 };
 
 #endif // __XINXING_H__
\ No newline at end of file
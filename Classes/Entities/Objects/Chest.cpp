@@ -42,7 +42,6 @@ bool Chest::init(ChestType type, bool randomType)
     if (_sprite)
     {
         _sprite->setAnchorPoint(Vec2(0.5f, 0.0f));
-        _sprite->setGlobalZOrder(Constants::ZOrder::ITEMS);
         this->addChild(_sprite);
     }
     
@@ -102,14 +101,8 @@ cocos2d::Vector<ItemDrop*> Chest::open(const std::unordered_map<std::string, int
             float offsetX = offsetDist(rng);
             float offsetY = offsetDist(rng);
             
+            // 掉落物由调用方挂到物件层
             drop->setPosition(this->getPosition() + Vec2(offsetX, offsetY));
-            drop->setGlobalZOrder(Constants::ZOrder::ITEMS);
-            
-            if (this->getParent())
-            {
-                this->getParent()->addChild(drop);
-            }
-            
             drops.pushBack(drop);
             
             // 更新临时计数
@@ -163,6 +156,10 @@ void RoomObjectManager::openChest(Player* player)
     auto drops = _chest->open(ownedItems);
     for (auto drop : drops)
     {
+        if (_chest->getParent())
+        {
+            _chest->getParent()->addChild(drop, Constants::ZOrder::ITEMS);
+        }
         _itemDrops.pushBack(drop);
     }
 }
@@ -205,16 +202,14 @@ void RoomObjectManager::createPortal(cocos2d::Node* parent, const cocos2d::Vec2&
     if (_portal)
     {
         _portal->setPosition(pos);
-        _portal->setGlobalZOrder(Constants::ZOrder::ITEMS);
-        parent->addChild(_portal);
+        parent->addChild(_portal, Constants::ZOrder::ITEMS);
     }
     
     _portalLighting = cocos2d::Sprite::create("Map/Portal/Portal_lighting.png");
     if (_portalLighting)
     {
         _portalLighting->setPosition(pos);
-        _portalLighting->setGlobalZOrder(Constants::ZOrder::ITEMS - 1);
-        parent->addChild(_portalLighting);
+        parent->addChild(_portalLighting, Constants::ZOrder::ITEMS - 1);
         
         auto fadeOut = cocos2d::FadeOut::create(0.5f);
         auto fadeIn = cocos2d::FadeIn::create(0.5f);
@@ -26,7 +26,7 @@ public:
     // 检测玩家是否可以与宝箱交互
     bool canInteract(Player* player, float interactionDistance = 0.0f) const;
     
-    // 打开宝箱：播放动画、抽取道具、生成掉落物
+    // 打开宝箱：播放动画、抽取道具、生成掉落物（掉落物由调用方添加到场景）
     cocos2d::Vector<class ItemDrop*> open(const std::unordered_map<std::string, int>& ownedItems);
     
     // Getter
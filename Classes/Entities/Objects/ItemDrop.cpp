@@ -39,7 +39,6 @@ bool ItemDrop::init(const ItemDef* itemDef)
     float scale = targetSize / _sprite->getContentSize().width;
     _sprite->setScale(scale);
     
-    _sprite->setGlobalZOrder(Constants::ZOrder::FLOOR + 2);
     this->addChild(_sprite);
     
     // 添加浮动动画效果
@@ -62,7 +62,6 @@ bool Portal::init()
     float targetSize = Constants::FLOOR_TILE_SIZE * 3.0f;
     float scale = targetSize / _portalSprite->getContentSize().width;
     _portalSprite->setScale(scale);
-    _portalSprite->setGlobalZOrder(Constants::ZOrder::FLOOR + 2);
     this->addChild(_portalSprite);
     
     // 播放传送门主体动画（循环）
@@ -96,8 +95,7 @@ bool Portal::init()
         if (_lightingSprite)
         {
             _lightingSprite->setScale(scale);
-            _lightingSprite->setGlobalZOrder(Constants::ZOrder::FLOOR + 3);
-            this->addChild(_lightingSprite);
+            this->addChild(_lightingSprite, 1);
             
             // 播放闪电动画（循环，速度更快）
             auto lightingAnimation = Animation::createWithSpriteFrames(lightingFrames, 0.08f);
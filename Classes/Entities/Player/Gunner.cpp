@@ -2,9 +2,11 @@
 #include "Entities/Enemy/Enemy.h"
 #include "Map/Room.h"
 #include "Map/Hallway.h"
-#include "UI/FloatingText.h"
+#include "Entities/Base/DamageQueue.h"
+#include "Utils/VfxShapes.h"
 #include "audio/include/AudioEngine.h"
 #include "Managers/SoundManager.h"
+#include "Utils/LeakTracker.h"
 
 Gunner::Gunner()
     : _isEnhanced(false)
@@ -23,6 +25,7 @@ Gunner::~Gunner()
     {
         if (pair.second)
         {
+            LEAK_TRACK_RELEASE(pair.second);
             pair.second->release();
         }
     }
@@ -99,6 +102,7 @@ void Gunner::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["idle"] = anim;
         }
     }
@@ -120,6 +124,7 @@ void Gunner::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["move"] = anim;
         }
     }
@@ -141,6 +146,7 @@ void Gunner::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["attack"] = anim;
         }
     }
@@ -162,6 +168,7 @@ void Gunner::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay * 1.5f);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["die"] = anim;
         }
     }
@@ -183,6 +190,7 @@ void Gunner::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_idle"] = anim;
         }
     }
@@ -204,6 +212,7 @@ void Gunner::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_move"] = anim;
         }
     }
@@ -225,6 +234,7 @@ void Gunner::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_attack"] = anim;
         }
     }
@@ -360,11 +370,9 @@ void Gunner::attack()
         // 连续发射5枚子弹，间隔0.05秒，体现距离紧密
         for (int i = 0; i < 5; i++)
         {
-            auto delay = DelayTime::create(i * 0.05f);
-            auto shoot = CallFunc::create([this, damage]() {
+            scheduleTimer(i * 0.05f, [this, damage]() {
                 this->shootBullet(damage);
             });
-            this->runAction(Sequence::create(delay, shoot, nullptr));
         }
         
         GAME_LOG("Wisdael Passive Triggered! 5-Burst. Damage: %d", damage);
@@ -380,15 +388,12 @@ void Gunner::attack()
     }
     
     // 攻击动画结束后返回IDLE
-    auto delay = DelayTime::create(0.3f);
-    auto callback = CallFunc::create([this]() {
+    scheduleTimer(0.3f, [this]() {
         if (_currentState == EntityState::ATTACK && !isDead())
         {
             setState(EntityState::IDLE);
         }
     });
-    auto sequence = Sequence::create(delay, callback, nullptr);
-    this->runAction(sequence);
 }
 
 void Gunner::useSkill()
@@ -411,15 +416,12 @@ void Gunner::useSkill()
              _enhancedDuration, getMP(), getMaxMP());
     
     // 技能动画结束后返回IDLE
-    auto delay = DelayTime::create(0.5f);
-    auto callback = CallFunc::create([this]() {
+    scheduleTimer(0.5f, [this]() {
         if (getState() == EntityState::SKILL && !isDead())
         {
             setState(EntityState::IDLE);
         }
     });
-    auto sequence = Sequence::create(delay, callback, nullptr);
-    this->runAction(sequence);
 }
 
 void Gunner::enterEnhancedState()
@@ -484,8 +486,6 @@ void Gunner::shootBullet(int damage)
     float scale = targetSize / bullet->getContentSize().width;
     bullet->setScale(scale);
     
-    bullet->setGlobalZOrder(Constants::ZOrder::PROJECTILE);
-    
     // 根据朝向旋转子弹
     float angle = CC_RADIANS_TO_DEGREES(atan2(_facingDirection.y, _facingDirection.x));
     bullet->setRotation(-angle);
@@ -596,7 +596,7 @@ void Gunner::shootBullet(int damage)
                     float dist = bulletPos.distance(child->getPosition());
                     if (dist < 35.0f)
                     {
-                        auto enemy = dynamic_cast<Enemy*>(child);
+                        auto enemy = Enemy::asEnemy(child);
                         if (enemy != nullptr && !enemy->isDead())
                         {
                             if (enemy->isStealthed()) continue;
@@ -641,16 +641,9 @@ void Gunner::shootSkillBomb()
 // 创建爆炸效果并造成范围伤害
 void Gunner::createExplosion(Node* parent, const Vec2& pos, int damage, float radius)
 {
-    // 可视化：绘制有色半透明圆圈
-    auto debugDraw = DrawNode::create();
-    // 红色，透明度0.3
-    debugDraw->drawSolidCircle(Vec2::ZERO, radius, 0.0f, 30, Color4F(1.0f, 0.0f, 0.0f, 0.3f));
-    debugDraw->setPosition(pos);
-    debugDraw->setGlobalZOrder(Constants::ZOrder::PROJECTILE + 1);
-    parent->addChild(debugDraw);
-    
-    // 0.5秒后淡出并移除
-    debugDraw->runAction(Sequence::create(FadeOut::create(0.5f), RemoveSelf::create(), nullptr));
+    // 可视化：红色半透明圆圈（透明度0.3），0.5秒内淡出并回收
+    VfxShapes::spawnDisc(parent, pos, radius, Color4F(1.0f, 0.0f, 0.0f, 0.3f),
+                         0.0f, 0.5f, Constants::ZOrder::PROJECTILE + 1);
 
     // 创建爆炸视觉效果
     Vector<SpriteFrame*> boomFrames;
@@ -671,8 +664,7 @@ void Gunner::createExplosion(Node* parent, const Vec2& pos, int damage, float ra
         explosion->setPosition(pos);
         // 根据爆炸半径调整大小，基准半径50.0f对应scale 1.0
         explosion->setScale(radius / 50.0f);
-        explosion->setGlobalZOrder(Constants::ZOrder::PROJECTILE + 1);
-        parent->addChild(explosion);
+        parent->addChild(explosion, Constants::ZOrder::PROJECTILE + 1);
         
         auto animation = Animation::createWithSpriteFrames(boomFrames, 0.08f);
         auto animate = Animate::create(animation);
@@ -689,7 +681,7 @@ void Gunner::createExplosion(Node* parent, const Vec2& pos, int damage, float ra
             float dist = pos.distance(child->getPosition());
             if (dist < radius)
             {
-                auto enemy = dynamic_cast<Enemy*>(child);
+                auto enemy = Enemy::asEnemy(child);
                 if (enemy != nullptr && !enemy->isDead() && !enemy->isStealthed())
                 {
                     enemiesToHit.push_back(enemy);
@@ -698,19 +690,10 @@ void Gunner::createExplosion(Node* parent, const Vec2& pos, int damage, float ra
         }
     }
     
-    // 对收集到的敌人造成伤害
+    // 对收集到的敌人造成伤害（伤害阶段统一结算）
     for (auto enemy : enemiesToHit)
     {
-        if (enemy && !enemy->isDead())
-        {
-            int oldHP = enemy->getHP();
-            enemy->takeDamage(damage);
-            int applied = oldHP - enemy->getHP();
-            if (applied > 0)
-            {
-                FloatingText::show(parent, enemy->getPosition(), std::to_string(applied), Color3B(255, 100, 0));
-            }
-            GAME_LOG("Explosion hits enemy for %d damage!", applied);
-        }
+        DamageQueue::getInstance()->push(enemy, damage, Color3B(255, 100, 0));
     }
+    GAME_LOG("Explosion hits %d enemies for %d damage!", static_cast<int>(enemiesToHit.size()), damage);
 }
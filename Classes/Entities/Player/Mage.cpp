@@ -2,9 +2,10 @@
 #include "Entities/Enemy/Enemy.h"
 #include "Map/Room.h"
 #include "Map/Hallway.h"
-#include "UI/FloatingText.h"
+#include "Entities/Base/DamageQueue.h"
 #include "audio/include/AudioEngine.h"
 #include "Managers/SoundManager.h"
+#include "Utils/LeakTracker.h"
 
 Mage::Mage()
     : _isEnhanced(false)
@@ -23,6 +24,7 @@ Mage::~Mage()
     {
         if (pair.second)
         {
+            LEAK_TRACK_RELEASE(pair.second);
             pair.second->release();
         }
     }
@@ -101,6 +103,7 @@ void Mage::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["idle"] = anim;
         }
     }
@@ -122,6 +125,7 @@ void Mage::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["move"] = anim;
         }
     }
@@ -143,6 +147,7 @@ void Mage::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["attack"] = anim;
         }
     }
@@ -164,6 +169,7 @@ void Mage::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay * 1.5f);  // 死亡动画稍慢
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["die"] = anim;
         }
     }
@@ -186,6 +192,7 @@ void Mage::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_idle"] = anim;
         }
     }
@@ -207,6 +214,7 @@ void Mage::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_move"] = anim;
         }
     }
@@ -228,6 +236,7 @@ void Mage::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_attack"] = anim;
         }
     }
@@ -365,15 +374,12 @@ void Mage::attack()
     GAME_LOG("Nymph shoots bullet! Enhanced: %s", _isEnhanced ? "YES" : "NO");
     
     // 攻击动画结束后返回IDLE
-    auto delay = DelayTime::create(0.3f);
-    auto callback = CallFunc::create([this]() {
+    scheduleTimer(0.3f, [this]() {
         if (_currentState == EntityState::ATTACK && !isDead())
         {
             setState(EntityState::IDLE);
         }
     });
-    auto sequence = Sequence::create(delay, callback, nullptr);
-    this->runAction(sequence);
 }
 
 void Mage::useSkill()
@@ -397,15 +403,12 @@ void Mage::useSkill()
              _enhancedDuration, getMP(), getMaxMP());
     
     // 技能动画结束后返回IDLE
-    auto delay = DelayTime::create(0.5f);
-    auto callback = CallFunc::create([this]() {
+    scheduleTimer(0.5f, [this]() {
         if (getState() == EntityState::SKILL && !isDead())
         {
             setState(EntityState::IDLE);
         }
     });
-    auto sequence = Sequence::create(delay, callback, nullptr);
-    this->runAction(sequence);
 }
 
 void Mage::enterEnhancedState()
@@ -484,9 +487,6 @@ void Mage::shootBullet()
     float scale = targetSize / bullet->getContentSize().width;
     bullet->setScale(scale);
     
-    // 设置层级
-    bullet->setGlobalZOrder(Constants::ZOrder::PROJECTILE);
-    
     // 根据朝向旋转子弹
     float angle = CC_RADIANS_TO_DEGREES(atan2(_facingDirection.y, _facingDirection.x));
     bullet->setRotation(-angle);
@@ -604,22 +604,15 @@ void Mage::shootBullet()
                     float dist = bulletPos.distance(child->getPosition());
                     if (dist < 35.0f)
                     {
-                        auto enemy = dynamic_cast<Enemy*>(child);
+                        auto enemy = Enemy::asEnemy(child);
                         if (enemy != nullptr && !enemy->isDead())
                         {
                             // 跳过隐身敌人（隐身不被我方子弹命中）
                             if (enemy->isStealthed()) continue;
 
-                            // 变更点：不要直接调用 takeDamageReported（会绕过子类的 takeDamage 覆写）
-                            // 先记录命中前的 HP，然后调用虚拟的 takeDamage，最后通过差值得到实际生效值用于浮字显示
-                            int oldHP = enemy->getHP();
-                            enemy->takeDamage(bulletDamage); // 虚函数调用，子类可以控制实际生效的数值
-                            int applied = oldHP - enemy->getHP();
-                            if (applied > 0)
-                            {
-                                FloatingText::show(parent, enemy->getPosition(), std::to_string(applied), Color3B(220,20,20));
-                            }
-                            GAME_LOG("Bullet hits enemy for %d (applied=%d) damage!", bulletDamage, applied);
+                            // 排入伤害队列，实际生效值与浮字在伤害阶段统一结算
+                            DamageQueue::getInstance()->push(enemy, bulletDamage, Color3B(220,20,20));
+                            GAME_LOG("Bullet hits enemy for %d damage!", bulletDamage);
 
                             // 如果处于强化（开大），额外造成 当前毒层数 * 自身攻击 * 10% 的伤害
                             if (this->_isEnhanced)
@@ -631,15 +624,8 @@ void Mage::shootBullet()
                                     int extraDmg = static_cast<int>(std::round(extraF));
                                     if (extraDmg > 0)
                                     {
-                                        int oldHP2 = enemy->getHP();
-                                        enemy->takeDamage(extraDmg);
-                                        int appliedExtra = oldHP2 - enemy->getHP();
-                                        if (appliedExtra > 0)
-                                        {
-                                            // 显示额外伤害
-                                            FloatingText::show(parent, enemy->getPosition(), std::to_string(appliedExtra), Color3B(220,20,20));
-                                        }
-                                        GAME_LOG("Enhanced extra damage: %d (stacks=%d, applied=%d)", extraDmg, stacksBefore, appliedExtra);
+                                        DamageQueue::getInstance()->push(enemy, extraDmg, Color3B(220,20,20));
+                                        GAME_LOG("Enhanced extra damage: %d (stacks=%d)", extraDmg, stacksBefore);
                                     }
                                 }
                             }
@@ -1,5 +1,6 @@
 ﻿#include "Player.h"
 #include "UI/FloatingText.h"
+#include "Utils/VfxShapes.h"
 #include "Scenes/GameScene.h"
 #include "Entities/Enemy/NiLuFire.h"
 
@@ -356,9 +357,11 @@ void Player::useHeal()
         {
             for (auto node : children)
             {
-                // 尝试转换为 NiLuFire
-                if (auto niluFire = dynamic_cast<NiLuFire*>(node))
+                // 按种类筛选 NiLuFire
+                Enemy* enemy = Enemy::asEnemy(node);
+                if (enemy && enemy->isKind(EnemyKind::NILU_FIRE))
                 {
+                    auto niluFire = static_cast<NiLuFire*>(enemy);
                     // 只要没死（状态不是DIE）就可以治疗
                     if (niluFire->getState() != EntityState::DIE)
                     {
@@ -438,28 +441,19 @@ void Player::attack()
     // 显示攻击范围特效
     if (this->getParent() != nullptr)
     {
-        auto attackEffect = DrawNode::create();
-        // 绘制扇形攻击范围
+        // 绘制攻击范围，快速淡出后回收
         Vec2 attackPos = this->getPosition() + _facingDirection * 40;
-        attackEffect->drawSolidCircle(attackPos, 50.0f, 0, 16, Color4F(1.0f, 1.0f, 0.0f, 0.5f));
-        this->getParent()->addChild(attackEffect, Constants::ZOrder::EFFECT);
-        
-        // 攻击特效快速消失
-        auto fadeOut = FadeOut::create(0.2f);
-        auto remove = RemoveSelf::create();
-        attackEffect->runAction(Sequence::create(fadeOut, remove, nullptr));
+        VfxShapes::spawnDisc(this->getParent(), attackPos, 50.0f, Color4F(1.0f, 1.0f, 0.0f, 0.5f),
+                             0.0f, 0.2f, Constants::ZOrder::EFFECT);
     }
     
     // 攻击动画结束后返回IDLE
-    auto delay = DelayTime::create(0.3f);
-    auto callback = CallFunc::create([this]() {
+    scheduleTimer(0.3f, [this]() {
         if (_currentState == EntityState::ATTACK)
         {
             setState(EntityState::IDLE);
         }
     });
-    auto sequence = Sequence::create(delay, callback, nullptr);
-    this->runAction(sequence);
 }
 
 void Player::takeDamage(int damage)
@@ -523,22 +517,13 @@ void Player::takeDamage(int damage)
         }
 
         // 短暂硬直后恢复
-        auto delay = DelayTime::create(0.2f);
-        auto callback = CallFunc::create([this]() {
+        scheduleTimer(0.2f, [this]() {
             // 确保恢复状态时还活着
             if (_currentState == EntityState::HIT && !isDead())
             {
                 setState(EntityState::IDLE);
             }
         });
-        auto sequence = Sequence::create(delay, callback, nullptr);
-        this->runAction(sequence);
-    }
-
-    // 显示玩家受伤的红色数字
-    if (this->getParent())
-    {
-        FloatingText::show(this->getParent(), this->getPosition(), std::to_string(damage), Color3B(220,20,20));
     }
 }
 // 道具增益实现
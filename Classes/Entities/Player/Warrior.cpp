@@ -4,8 +4,11 @@
 #include "Map/Room.h"
 #include "Map/Hallway.h"
 #include "UI/FloatingText.h"
+#include "Entities/Base/DamageQueue.h"
+#include "Utils/VfxShapes.h"
 #include "audio/include/AudioEngine.h"
 #include "Managers/SoundManager.h"
+#include "Utils/LeakTracker.h"
 
 USING_NS_CC;
 
@@ -30,6 +33,7 @@ Warrior::~Warrior()
     {
         if (pair.second)
         {
+            LEAK_TRACK_RELEASE(pair.second);
             pair.second->release();
         }
     }
@@ -123,6 +127,7 @@ void Warrior::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["idle"] = anim;
         }
     }
@@ -144,6 +149,7 @@ void Warrior::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["move"] = anim;
         }
     }
@@ -165,6 +171,7 @@ void Warrior::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, 0.08f);  // 攻击动画快一些
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["attack"] = anim;
         }
     }
@@ -186,6 +193,7 @@ void Warrior::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay * 1.5f);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["die"] = anim;
         }
     }
@@ -207,6 +215,7 @@ void Warrior::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_idle"] = anim;
         }
     }
@@ -228,6 +237,7 @@ void Warrior::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, frameDelay);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_move"] = anim;
         }
     }
@@ -249,6 +259,7 @@ void Warrior::initAnimations()
         {
             auto anim = Animation::createWithSpriteFrames(frames, 0.08f);
             anim->retain();
+            LEAK_TRACK_RETAIN(anim);
             _animations["skill_attack"] = anim;
         }
     }
@@ -396,15 +407,12 @@ void Warrior::attack()
     GAME_LOG("Mudrock melee attack! Enhanced: %s", _isEnhanced ? "YES" : "NO");
     
     // 攻击动画结束后返回IDLE
-    auto delay = DelayTime::create(0.4f);
-    auto callback = CallFunc::create([this]() {
+    scheduleTimer(0.4f, [this]() {
         if (_currentState == EntityState::ATTACK && !isDead())
         {
             setState(EntityState::IDLE);
         }
     });
-    auto sequence = Sequence::create(delay, callback, nullptr);
-    this->runAction(sequence);
 }
 
 void Warrior::useSkill()
@@ -438,15 +446,12 @@ void Warrior::useSkill()
              healAmount, _enhancedDuration, getMP(), getMaxMP());
     
     // 技能动画结束后返回IDLE
-    auto delay = DelayTime::create(0.5f);
-    auto callback = CallFunc::create([this]() {
+    scheduleTimer(0.5f, [this]() {
         if (getState() == EntityState::SKILL && !isDead())
         {
             setState(EntityState::IDLE);
         }
     });
-    auto sequence = Sequence::create(delay, callback, nullptr);
-    this->runAction(sequence);
 }
 
 void Warrior::enterEnhancedState()
@@ -514,7 +519,7 @@ void Warrior::performMeleeAttack()
     {
         if (child->getTag() == Constants::Tag::ENEMY)
         {
-            auto enemy = dynamic_cast<Enemy*>(child);
+            auto enemy = Enemy::asEnemy(child);
             if (enemy == nullptr || enemy->isDead() || enemy->isStealthed())
             {
                 continue;
@@ -556,51 +561,17 @@ void Warrior::performMeleeAttack()
         addShield(shieldAmount);
     }
     
-    // 对收集到的敌人造成伤害
+    // 对收集到的敌人造成伤害（伤害阶段统一结算）
     for (auto enemy : enemiesToHit)
     {
-        if (enemy && !enemy->isDead())
-        {
-            Vec2 enemyPos = enemy->getPosition();
-            int oldHP = enemy->getHP();
-            enemy->takeDamage(damage);
-            int applied = oldHP - enemy->getHP();
-            
-            if (applied > 0)
-            {
-                FloatingText::show(parent, enemyPos, std::to_string(applied), Color3B(255, 150, 0));
-            }
-            
-            GAME_LOG("Melee hit enemy for %d damage!", applied);
-        }
+        DamageQueue::getInstance()->push(enemy, damage, Color3B(255, 150, 0));
     }
+    GAME_LOG("Melee hits %d enemies for %d damage!", static_cast<int>(enemiesToHit.size()), damage);
     
-    // 显示攻击范围视觉效果（可选）
-    auto attackEffect = DrawNode::create();
-    attackEffect->setPosition(playerPos);
-    attackEffect->setGlobalZOrder(Constants::ZOrder::ENTITY - 1);
-    
-    // 绘制扇形攻击范围
-    std::vector<Vec2> points;
-    points.push_back(Vec2::ZERO);
-    int segments = 12;
-    float startAngle = CC_RADIANS_TO_DEGREES(atan2(attackDir.y, attackDir.x)) - attackAngle / 2.0f;
-    for (int i = 0; i <= segments; i++)
-    {
-        float angle = CC_DEGREES_TO_RADIANS(startAngle + (attackAngle * i / segments));
-        points.push_back(Vec2(cos(angle) * attackRange, sin(angle) * attackRange));
-    }
-    
-    attackEffect->drawPolygon(points.data(), points.size(), 
-                              Color4F(1.0f, 0.5f, 0.0f, 0.3f), 
-                              2.0f, Color4F(1.0f, 0.7f, 0.0f, 0.6f));
-    
-    parent->addChild(attackEffect);
-    
-    // 短暂显示后移除
-    auto fadeOut = FadeOut::create(0.3f);
-    auto remove = RemoveSelf::create();
-    attackEffect->runAction(Sequence::create(fadeOut, remove, nullptr));
+    // 显示扇形攻击范围（橙色填充 + 描边，短暂淡出后回收）
+    float facing = CC_RADIANS_TO_DEGREES(atan2(attackDir.y, attackDir.x));
+    VfxShapes::spawnFan(parent, playerPos, attackRange, attackAngle, facing,
+                        Color4F(1.0f, 0.6f, 0.0f, 0.6f), 0.0f, 0.3f, Constants::ZOrder::ENTITY - 1);
 }
 
 void Warrior::addShield(int amount)
@@ -0,0 +1,227 @@
+﻿#include "AssetPreloader.h"
+#include "Managers/TextureBudget.h"
+#include "UI/CharacterSelectLayer.h"
+#include "Entities/Enemy/EnemyKinds.h"
+#include "audio/include/AudioEngine.h"
+#include <algorithm>
+
+using cocos2d::AudioEngine;
+
+namespace {
+
+// 递归收集目录下的所有 png（目录不存在时静默跳过）
+void collectTextures(const std::string& dir, std::vector<std::string>& out)
+{
+    auto fileUtils = FileUtils::getInstance();
+    if (!fileUtils->isDirectoryExist(dir))
+    {
+        GAME_LOG_ERROR("AssetPreloader: directory not found %s", dir.c_str());
+        return;
+    }
+    
+    std::vector<std::string> files;
+    fileUtils->listFilesRecursively(dir, &files);
+    for (const auto& file : files)
+    {
+        if (fileUtils->getFileExtension(file) == ".png")
+        {
+            out.push_back(file);
+        }
+    }
+}
+
+} // namespace
+
+AssetPreloader* AssetPreloader::create()
+{
+    AssetPreloader* ret = new (std::nothrow) AssetPreloader();
+    if (ret)
+    {
+        ret->autorelease();
+    }
+    return ret;
+}
+
+AssetPreloader::AssetPreloader()
+    : _alive(std::make_shared<bool>(true))
+    , _loadedCount(0)
+    , _totalCount(0)
+    , _loading(false)
+    , _finished(false)
+{
+}
+
+AssetPreloader::~AssetPreloader()
+{
+    cancel();
+}
+
+AssetManifest AssetPreloader::buildLevelManifest(int level, int stage)
+{
+    AssetManifest manifest;
+    std::vector<std::string> dirs;
+    
+    // 玩家角色：只加载当前选择的角色
+    std::string sfxPrefix;
+    switch (CharacterSelectLayer::getSelectedCharacter())
+    {
+        case CharacterType::GUNNER:
+            dirs.push_back("Player/Wisdael");
+            sfxPrefix = "Wisdael";
+            break;
+        case CharacterType::WARRIOR:
+            dirs.push_back("Player/Mudrock");
+            sfxPrefix = "MudRock";
+            break;
+        case CharacterType::MAGE:
+        default:
+            dirs.push_back("Player/Nymph");
+            sfxPrefix = "Nymph";
+            break;
+    }
+    
+    // 地图与UI
+    dirs.push_back("Map/Floor");
+    dirs.push_back("Map/Wall");
+    dirs.push_back("Map/Door");
+    dirs.push_back("Map/Barrier");
+    dirs.push_back("Map/Chest");
+    dirs.push_back("Map/Portal");
+    dirs.push_back("UIs");
+    dirs.push_back("Property");
+    
+    // 敌人阵容：取自特性表，与 GameScene::initEnemyPool 预留的种类一致（Boss 层含 Boss、初始小怪与各阶段召唤物）
+    bool bossFloor = (stage == 0);
+    std::vector<EnemyKind> kinds;
+    EnemyKinds::collectLevelKinds(bossFloor, kinds);
+    for (EnemyKind kind : kinds)
+    {
+        std::string dir = EnemyKinds::traits(kind).assetDir;
+        if (!dir.empty() && std::find(dirs.begin(), dirs.end(), dir) == dirs.end())
+        {
+            dirs.push_back(dir);
+        }
+    }
+    manifest.audios.push_back(bossFloor ? "Music/Boss_Battle.mp3" : "Music/Game_Battle.mp3");
+    
+    for (const auto& dir : dirs)
+    {
+        collectTextures(dir, manifest.textures);
+    }
+    
+    manifest.audios.push_back("SoundEffect/" + sfxPrefix + "_Attack.mp3");
+    manifest.audios.push_back("SoundEffect/" + sfxPrefix + "_Skill_Attack.mp3");
+    
+    GAME_LOG("AssetPreloader: manifest for %d-%d has %d textures, %d audios",
+             level, stage, (int)manifest.textures.size(), (int)manifest.audios.size());
+    return manifest;
+}
+
+void AssetPreloader::start(const AssetManifest& manifest,
+                           const std::function<void(int, int)>& progress,
+                           const std::function<void()>& done)
+{
+    cancel();
+    
+    _progressCallback = progress;
+    _doneCallback = done;
+    _loadedCount = 0;
+    _totalCount = (int)manifest.size();
+    _loading = true;
+    _finished = false;
+    _alive = std::make_shared<bool>(true);
+    
+    if (_totalCount == 0)
+    {
+        _loading = false;
+        _finished = true;
+        if (_doneCallback) _doneCallback();
+        return;
+    }
+    
+    // 先登记再提交：已在缓存中的纹理会同步回调
+    _pendingTextures.insert(manifest.textures.begin(), manifest.textures.end());
+    
+    auto textureCache = Director::getInstance()->getTextureCache();
+    for (const auto& path : manifest.textures)
+    {
+        textureCache->addImageAsync(path, [this, path](Texture2D* texture) {
+            _pendingTextures.erase(path);
+            if (!texture)
+            {
+                GAME_LOG_ERROR("AssetPreloader: failed to load %s", path.c_str());
+            }
+            onItemLoaded();
+        });
+        if (!_loading) return;  // 回调中可能已被取消
+    }
+    
+    std::weak_ptr<bool> alive = _alive;
+    for (const auto& path : manifest.audios)
+    {
+        if (!FileUtils::getInstance()->isFileExist(path))
+        {
+            GAME_LOG_ERROR("AssetPreloader: audio not found %s", path.c_str());
+            onItemLoaded();
+            continue;
+        }
+        
+        AudioEngine::preload(path, [this, alive, path](bool success) {
+            // 音频回调无法撤销，加载器取消或析构后直接忽略
+            auto token = alive.lock();
+            if (!token || !*token) return;
+            if (!success)
+            {
+                GAME_LOG_ERROR("AssetPreloader: failed to load %s", path.c_str());
+            }
+            onItemLoaded();
+        });
+        if (!_loading) return;
+    }
+}
+
+void AssetPreloader::cancel()
+{
+    if (_alive)
+    {
+        *_alive = false;
+    }
+    
+    if (!_pendingTextures.empty())
+    {
+        auto textureCache = Director::getInstance()->getTextureCache();
+        for (const auto& path : _pendingTextures)
+        {
+            textureCache->unbindImageAsync(path);
+        }
+        _pendingTextures.clear();
+    }
+    
+    _loading = false;
+    _progressCallback = nullptr;
+    _doneCallback = nullptr;
+}
+
+void AssetPreloader::onItemLoaded()
+{
+    if (!_loading) return;
+    
+    _loadedCount++;
+    if (_progressCallback)
+    {
+        _progressCallback(_loadedCount, _totalCount);
+    }
+    
+    if (_loadedCount >= _totalCount)
+    {
+        _loading = false;
+        _finished = true;
+        GAME_LOG("AssetPreloader: %d assets resident", _totalCount);
+        
+        // 先清空回调再调用，回调中可以安全地重新 start
+        auto done = _doneCallback;
+        _progressCallback = nullptr;
+        _doneCallback = nullptr;
+        if (done) done();
+    }
+}
@@ -0,0 +1,64 @@
+﻿#ifndef __ASSET_PRELOADER_H__
+#define __ASSET_PRELOADER_H__
+
+#include "cocos2d.h"
+#include "Core/Constants.h"
+#include "Core/GameMacros.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+USING_NS_CC;
+
+// 关卡资源清单：进入某一关前需要常驻内存的纹理与音频
+struct AssetManifest {
+    std::vector<std::string> textures;   // 纹理完整路径
+    std::vector<std::string> audios;     // 音频相对路径
+    
+    size_t size() const { return textures.size() + audios.size(); }
+};
+
+// 资源预加载器 - 通过 TextureCache 异步接口在工作线程解码纹理，主线程只接收回调
+// 由 LoadingScene（以及关卡内的后台预取）持有，析构/取消时会解绑尚未完成的回调
+class AssetPreloader : public Ref {
+public:
+    static AssetPreloader* create();
+    
+    // 根据关卡信息生成资源清单（角色、敌人阵容、地图、UI，Boss层额外包含Boss资源）
+    static AssetManifest buildLevelManifest(int level, int stage);
+    
+    // 开始异步加载；progress(已完成数, 总数) 每完成一项回调一次，done 在全部完成后回调一次
+    // 只负责解码，不登记 TextureBudget 的关卡清单（由真正进入关卡的一方调用 beginLevel）
+    void start(const AssetManifest& manifest,
+               const std::function<void(int, int)>& progress,
+               const std::function<void()>& done);
+    
+    // 取消加载（已经解码完成的纹理仍保留在缓存中）
+    void cancel();
+    
+    bool isLoading() const { return _loading; }
+    bool isFinished() const { return _finished; }
+    int getLoadedCount() const { return _loadedCount; }
+    int getTotalCount() const { return _totalCount; }
+    
+private:
+    AssetPreloader();
+    virtual ~AssetPreloader();
+    
+    // 单项完成（无论成功与否都计数，保证进度能走到终点）
+    void onItemLoaded();
+    
+private:
+    std::unordered_set<std::string> _pendingTextures;   // 已提交但未回调的纹理
+    std::function<void(int, int)> _progressCallback;
+    std::function<void()> _doneCallback;
+    std::shared_ptr<bool> _alive;                // 音频回调无法解绑，用存活标记屏蔽过期回调
+    int _loadedCount;
+    int _totalCount;
+    bool _loading;
+    bool _finished;
+};
+
+#endif // __ASSET_PRELOADER_H__
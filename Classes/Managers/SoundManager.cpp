@@ -1,4 +1,5 @@
 ﻿#include "SoundManager.h"
+#include "Utils/HitchDetector.h"
 
 using cocos2d::AudioEngine;
 
@@ -167,7 +168,10 @@ int SoundManager::playSFX(const std::string& filePath, bool loop)
     }
 
     // 如果没有预加载，先预加载一次（同步等待）
-    AudioEngine::preload(filePath);
+    {
+        HitchScope scope("preloadSFX", filePath);
+        AudioEngine::preload(filePath);
+    }
 
     int audioID = AudioEngine::play2d(filePath, loop, _sfxVolume);
 
@@ -0,0 +1,231 @@
+﻿#include "TextureBudget.h"
+#include "Managers/AssetPreloader.h"
+#include <algorithm>
+#include <vector>
+
+TextureBudget* TextureBudget::_instance = nullptr;
+
+namespace {
+    double nowSeconds()
+    {
+        return utils::gettime();
+    }
+}
+
+TextureBudget* TextureBudget::getInstance()
+{
+    if (_instance == nullptr)
+    {
+        _instance = new (std::nothrow) TextureBudget();
+    }
+    return _instance;
+}
+
+void TextureBudget::destroyInstance()
+{
+    CC_SAFE_DELETE(_instance);
+}
+
+TextureBudget::TextureBudget()
+    : _budgetBytes(DEFAULT_BUDGET_BYTES)
+    , _scheduled(false)
+{
+}
+
+TextureBudget::~TextureBudget()
+{
+    if (_scheduled)
+    {
+        Director::getInstance()->getScheduler()->unschedule("TextureBudget::sample", this);
+    }
+}
+
+void TextureBudget::ensureScheduled()
+{
+    if (_scheduled) return;
+    _scheduled = true;
+    Director::getInstance()->getScheduler()->schedule([this](float) {
+        sample();
+        enforceBudget();
+    }, this, SAMPLE_INTERVAL, false, "TextureBudget::sample");
+}
+
+void TextureBudget::beginLevel(const AssetManifest& manifest)
+{
+    _levelTextures.clear();
+    double now = nowSeconds();
+    for (const auto& path : manifest.textures)
+    {
+        _levelTextures.insert(path);
+        track(path);
+        // 新关卡需要的纹理视为刚刚使用过，淘汰时排在最后
+        _entries[path].lastUsed = now;
+    }
+    ensureScheduled();
+}
+
+void TextureBudget::track(const std::string& fullPath)
+{
+    if (_entries.find(fullPath) != _entries.end()) return;
+    Entry entry;
+    entry.group = groupForPath(fullPath);
+    entry.lastUsed = nowSeconds();
+    _entries.emplace(fullPath, entry);
+}
+
+void TextureBudget::sample()
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    double now = nowSeconds();
+    for (auto& pair : _entries)
+    {
+        Texture2D* texture = textureCache->getTextureForKey(pair.first);
+        if (!texture) continue;
+        pair.second.bytes = textureBytes(texture);
+        if (texture->getReferenceCount() > 1)
+        {
+            pair.second.lastUsed = now;
+        }
+    }
+}
+
+void TextureBudget::trimForLevel()
+{
+    sample();
+    
+    size_t freed = 0;
+    int count = 0;
+    for (auto& pair : _entries)
+    {
+        if (_levelTextures.count(pair.first)) continue;
+        size_t bytes = release(pair.first, pair.second);
+        if (bytes > 0)
+        {
+            freed += bytes;
+            count++;
+        }
+    }
+    GAME_LOG("TextureBudget: released %d textures (%.1f MB) not used by this level",
+             count, freed / (1024.0f * 1024.0f));
+    
+    enforceBudget();
+    logReport();
+}
+
+size_t TextureBudget::enforceBudget()
+{
+    size_t resident = getResidentBytes();
+    if (resident <= _budgetBytes) return 0;
+    
+    // 先淘汰清单外的纹理，再淘汰当前关卡暂未使用的纹理；同一梯队内按最近使用时间从旧到新
+    std::vector<std::pair<std::string, Entry*>> candidates;
+    candidates.reserve(_entries.size());
+    for (auto& pair : _entries)
+    {
+        candidates.emplace_back(pair.first, &pair.second);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [this](const std::pair<std::string, Entry*>& a, const std::pair<std::string, Entry*>& b) {
+            bool levelA = _levelTextures.count(a.first) > 0;
+            bool levelB = _levelTextures.count(b.first) > 0;
+            if (levelA != levelB) return !levelA;
+            return a.second->lastUsed < b.second->lastUsed;
+        });
+    
+    size_t freed = 0;
+    for (auto& candidate : candidates)
+    {
+        if (resident - freed <= _budgetBytes) break;
+        freed += release(candidate.first, *candidate.second);
+    }
+    
+    GAME_LOG("TextureBudget: over budget (%.1f / %.1f MB), evicted %.1f MB",
+             resident / (1024.0f * 1024.0f), _budgetBytes / (1024.0f * 1024.0f),
+             freed / (1024.0f * 1024.0f));
+    return freed;
+}
+
+size_t TextureBudget::release(const std::string& fullPath, Entry& entry)
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    Texture2D* texture = textureCache->getTextureForKey(fullPath);
+    if (!texture || texture->getReferenceCount() > 1) return 0;
+    
+    size_t bytes = textureBytes(texture);
+    textureCache->removeTexture(texture);
+    entry.bytes = 0;
+    return bytes;
+}
+
+size_t TextureBudget::getResidentBytes() const
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    size_t total = 0;
+    for (const auto& pair : _entries)
+    {
+        Texture2D* texture = textureCache->getTextureForKey(pair.first);
+        if (texture)
+        {
+            total += textureBytes(texture);
+        }
+    }
+    return total;
+}
+
+void TextureBudget::logReport() const
+{
+    auto textureCache = Director::getInstance()->getTextureCache();
+    std::unordered_map<std::string, std::pair<size_t, int>> groups;
+    size_t total = 0;
+    for (const auto& pair : _entries)
+    {
+        Texture2D* texture = textureCache->getTextureForKey(pair.first);
+        if (!texture) continue;
+        size_t bytes = textureBytes(texture);
+        auto& group = groups[pair.second.group];
+        group.first += bytes;
+        group.second++;
+        total += bytes;
+    }
+    
+    std::vector<std::pair<std::string, std::pair<size_t, int>>> sorted(groups.begin(), groups.end());
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, std::pair<size_t, int>>& a,
+                                               const std::pair<std::string, std::pair<size_t, int>>& b) {
+        return a.second.first > b.second.first;
+    });
+    
+    GAME_LOG("TextureBudget: resident %.1f MB / budget %.1f MB",
+             total / (1024.0f * 1024.0f), _budgetBytes / (1024.0f * 1024.0f));
+    for (const auto& group : sorted)
+    {
+        GAME_LOG("  %-36s %8.1f KB  (%d)", group.first.c_str(),
+                 group.second.first / 1024.0f, group.second.second);
+    }
+}
+
+std::string TextureBudget::groupForPath(const std::string& fullPath)
+{
+    // 去掉搜索路径前缀，得到相对资源根目录的路径
+    std::string relative = fullPath;
+    for (const auto& searchPath : FileUtils::getInstance()->getSearchPaths())
+    {
+        if (!searchPath.empty() && fullPath.compare(0, searchPath.size(), searchPath) == 0)
+        {
+            relative = fullPath.substr(searchPath.size());
+            break;
+        }
+    }
+    
+    // 取前两级目录（例如 Enemy/_BOSS_KuiLong）
+    size_t first = relative.find('/');
+    if (first == std::string::npos) return ".";
+    size_t second = relative.find('/', first + 1);
+    if (second == std::string::npos) return relative.substr(0, first);
+    return relative.substr(0, second);
+}
+
+size_t TextureBudget::textureBytes(Texture2D* texture)
+{
+    return static_cast<size_t>(texture->getPixelsWide()) * texture->getPixelsHigh()
+        * texture->getBitsPerPixelForFormat() / 8;
+}
@@ -0,0 +1,80 @@
+﻿#ifndef __TEXTURE_BUDGET_H__
+#define __TEXTURE_BUDGET_H__
+
+#include "cocos2d.h"
+#include "Core/Constants.h"
+#include "Core/GameMacros.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+USING_NS_CC;
+
+struct AssetManifest;
+
+// 纹理预算管理器 - 跟踪关卡清单中的纹理，跨楼层释放不再使用的纹理，并按预算做 LRU 淘汰
+// 只淘汰仅被 TextureCache 持有（引用计数为 1）的纹理；运行时生成的 "__vfx_*" 等纹理不在跟踪范围内
+class TextureBudget {
+public:
+    static TextureBudget* getInstance();
+    static void destroyInstance();
+    
+    // 默认预算（字节）与采样间隔（秒）
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 256u * 1024u * 1024u;
+    static constexpr float SAMPLE_INTERVAL = 2.0f;
+    
+    void setBudgetBytes(size_t bytes) { _budgetBytes = bytes; }
+    size_t getBudgetBytes() const { return _budgetBytes; }
+    
+    // 登记新关卡的纹理清单（之后的释放以该清单为准）
+    void beginLevel(const AssetManifest& manifest);
+    
+    // 登记单张纹理（完整路径）
+    void track(const std::string& fullPath);
+    
+    // 刷新仍被精灵/动画引用的纹理的最近使用时间
+    void sample();
+    
+    // 楼层切换完成后调用：释放新关卡清单外且无人引用的纹理，再按预算淘汰
+    void trimForLevel();
+    
+    // 超出预算时按最近使用时间淘汰无人引用的纹理，返回释放的字节数
+    size_t enforceBudget();
+    
+    // 当前常驻的已跟踪纹理字节数
+    size_t getResidentBytes() const;
+    
+    // 按资源目录输出常驻纹理字节数
+    void logReport() const;
+    
+private:
+    TextureBudget();
+    ~TextureBudget();
+    
+    TextureBudget(const TextureBudget&) = delete;
+    TextureBudget& operator=(const TextureBudget&) = delete;
+    
+    struct Entry {
+        std::string group;      // 资源目录（相对资源根目录的前两级）
+        size_t bytes = 0;       // 最近一次常驻时的字节数
+        double lastUsed = 0.0;  // 最近一次被引用的时间（秒）
+    };
+    
+    // 释放一张纹理（仍被引用时不释放），返回释放的字节数
+    size_t release(const std::string& fullPath, Entry& entry);
+    
+    static std::string groupForPath(const std::string& fullPath);
+    static size_t textureBytes(Texture2D* texture);
+    
+    void ensureScheduled();
+    
+private:
+    static TextureBudget* _instance;
+    
+    std::unordered_map<std::string, Entry> _entries;    // 完整路径 -> 跟踪信息
+    std::unordered_set<std::string> _levelTextures;     // 当前关卡清单
+    size_t _budgetBytes;
+    bool _scheduled;
+};
+
+#endif // __TEXTURE_BUDGET_H__
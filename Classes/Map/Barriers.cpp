@@ -1,5 +1,6 @@
 ﻿#include "Barriers.h"
 #include "Entities/Player/Player.h"
+#include "Entities/Base/DamageQueue.h"
 
 USING_NS_CC;
 
@@ -32,8 +33,6 @@ bool Spike::initWithTexturePath(const std::string& texturePath)
     this->setScaleX(scaleX);
     this->setScaleY(scaleY);
     
-    this->setGlobalZOrder(Constants::ZOrder::FLOOR + 1);
-    
     return true;
 }
 
@@ -85,7 +84,7 @@ void Spike::updateState(float dt, Player* player)
         _damageTimer -= dt;
         if (_damageTimer <= 0.0f)
         {
-            player->takeDamage(_damagePerTick);
+            DamageQueue::getInstance()->push(player, _damagePerTick, Color3B(220, 20, 20));
             _damageTimer = _damageInterval;
         }
     }
@@ -143,7 +142,6 @@ bool Box::initWithType(BoxType type)
     this->setScaleX(scaleX);
     this->setScaleY(scaleY);
     
-    this->setGlobalZOrder(Constants::ZOrder::WALL_ABOVE);
     this->setTag(Constants::Tag::WALL);  // 设置为墙壁标签，子弹会检测
     
     return true;
@@ -194,7 +192,6 @@ bool Pillar::initWithType(PillarType type)
     this->setScaleX(scaleX);
     this->setScaleY(scaleY);
     
-    this->setGlobalZOrder(Constants::ZOrder::WALL_ABOVE);
     this->setTag(Constants::Tag::WALL);  // 设置为墙壁标签，子弹会检测
     
     return true;
@@ -72,10 +72,10 @@ void BossFloor::generate(
     _bossRoom->setDoorOpen(Constants::DIR_LEFT, true);
     // PS: Boss房间与三阶段房间之间不设门，也不设走廊
     
-    // 创建房间地图
+    // 创建房间地图：起始房间立即构建，Boss房间和三阶段房间只计算布局，由 MapGenerator 延迟构建
     _startRoom->createMap();
-    _bossRoom->createMap();
-    _phase3Room->createMap();
+    _bossRoom->prepareLayout();
+    _phase3Room->prepareLayout();
     
     this->addChild(_startRoom);
     this->addChild(_bossRoom);
@@ -180,8 +180,7 @@ void BossFloor::generateFireTiles() {
         auto fireFloor = Sprite::create("Map/Floor/Floor_fire.png");
         if (fireFloor) {
             fireFloor->setPosition(posX, posY);
-            fireFloor->setGlobalZOrder(Constants::ZOrder::FLOOR + 2);
-            this->addChild(fireFloor, Constants::ZOrder::FLOOR + 2);
+            _bossRoom->getLayers().add(fireFloor, Constants::ZOrder::FLOOR + 2);
             _fireFloors.pushBack(fireFloor);
         }
     }
@@ -208,6 +207,7 @@ void BossFloor::generateHallway(std::vector<Hallway*>& hallways) {
         Hallway* hallway = Hallway::create(Constants::DIR_RIGHT);
         hallway->setGapSize(gapSize);
         hallway->setCenter(hallwayCenterX, hallwayCenterY);
+        hallway->setConnectedRooms(_startRoom, _bossRoom);
         hallway->createMap();
         hallways.push_back(hallway);
         this->addChild(hallway, Constants::ZOrder::FLOOR);
@@ -29,6 +29,10 @@ bool Hallway::initWithDirection(int direction) {
     _direction = direction;
     _centerX = 0.0f;
     _centerY = 0.0f;
+    _sleeping = false;
+    _materialized = false;
+    _fromRoom = nullptr;
+    _toRoom = nullptr;
     
     // 默认瓦片数，会在setGapSize中根据实际空隙重新计算
     if (_direction == Constants::DIR_UP || _direction == Constants::DIR_DOWN) {
@@ -61,12 +65,64 @@ void Hallway::setCenter(float x, float y) {
     _centerY = y;
 }
 
+void Hallway::setSleeping(bool sleeping) {
+    if (_sleeping == sleeping) return;
+    _sleeping = sleeping;
+    this->setVisible(!sleeping);
+    _layers.setVisible(!sleeping);
+}
+
+Rect Hallway::getBounds() const {
+    float tileSize = Constants::FLOOR_TILE_SIZE;
+    float width = _tilesWidth * tileSize;
+    float height = _tilesHeight * tileSize;
+    return Rect(_centerX - width / 2.0f, _centerY - height / 2.0f, width, height);
+}
+
 void Hallway::createMap() {
+    prepareLayout();
+    materialize();
+}
+
+void Hallway::prepareLayout() {
     float tileSize = Constants::FLOOR_TILE_SIZE;
     // 对于偶数瓦片，中心在两个瓦片之间
     float startX = _centerX - tileSize * (_tilesWidth / 2.0f - 0.5f);
     float startY = _centerY + tileSize * (_tilesHeight / 2.0f - 0.5f);
     
+    // 更新实际可行走边界（考虑玩家半径，边界往内缩）
+    float playerHalfSize = 15.0f;  // 玩家半径约15像素
+    
+    if (_direction == Constants::DIR_LEFT || _direction == Constants::DIR_RIGHT) {
+        // 水平走廊：纵向排除上下墙，并考虑玩家尺寸
+        _leftX = startX;
+        _rightX = startX + tileSize * (_tilesWidth - 1);
+        // 上墙
+        _topY = startY - tileSize / 2 - playerHalfSize;
+        // 下墙
+        _bottomY = startY - (_tilesHeight - 1) * tileSize + tileSize / 2 + playerHalfSize;
+    } else {
+        // 垂直走廊：横向排除左右墙，并考虑玩家尺寸
+        // 左墙在w=0，其右边缘在 startX + tileSize/2，再往右缩playerHalfSize
+        _leftX = startX + tileSize / 2 + playerHalfSize;
+        // 右墙在w=_tilesWidth-1，其左边缘在 startX + (_tilesWidth-1)*tileSize - tileSize/2，再往左缩
+        _rightX = startX + (_tilesWidth - 1) * tileSize - tileSize / 2 - playerHalfSize;
+        _topY = startY;
+        _bottomY = startY - tileSize * (_tilesHeight - 1);
+    }
+    
+    log("Hallway dir=%d center=(%.1f,%.1f) tiles=%dx%d walkable: X[%.1f,%.1f] Y[%.1f,%.1f]",
+        _direction, _centerX, _centerY, _tilesWidth, _tilesHeight, _leftX, _rightX, _bottomY, _topY);
+}
+
+void Hallway::materialize() {
+    if (_materialized) return;
+    _materialized = true;
+    
+    float tileSize = Constants::FLOOR_TILE_SIZE;
+    float startX = _centerX - tileSize * (_tilesWidth / 2.0f - 0.5f);
+    float startY = _centerY + tileSize * (_tilesHeight / 2.0f - 0.5f);
+    
     // 生成地板和墙壁
     for (int h = 0; h < _tilesHeight; h++) {
         for (int w = 0; w < _tilesWidth; w++) {
@@ -100,30 +156,6 @@ void Hallway::createMap() {
             }
         }
     }
-    
-    // 更新实际可行走边界（考虑玩家半径，边界往内缩）
-    float playerHalfSize = 15.0f;  // 玩家半径约15像素
-    
-    if (_direction == Constants::DIR_LEFT || _direction == Constants::DIR_RIGHT) {
-        // 水平走廊：纵向排除上下墙，并考虑玩家尺寸
-        _leftX = startX;
-        _rightX = startX + tileSize * (_tilesWidth - 1);
-        // 上墙
-        _topY = startY - tileSize / 2 - playerHalfSize;
-        // 下墙
-        _bottomY = startY - (_tilesHeight - 1) * tileSize + tileSize / 2 + playerHalfSize;
-    } else {
-        // 垂直走廊：横向排除左右墙，并考虑玩家尺寸
-        // 左墙在w=0，其右边缘在 startX + tileSize/2，再往右缩playerHalfSize
-        _leftX = startX + tileSize / 2 + playerHalfSize;
-        // 右墙在w=_tilesWidth-1，其左边缘在 startX + (_tilesWidth-1)*tileSize - tileSize/2，再往左缩
-        _rightX = startX + (_tilesWidth - 1) * tileSize - tileSize / 2 - playerHalfSize;
-        _topY = startY;
-        _bottomY = startY - tileSize * (_tilesHeight - 1);
-    }
-    
-    log("Hallway dir=%d center=(%.1f,%.1f) tiles=%dx%d walkable: X[%.1f,%.1f] Y[%.1f,%.1f]",
-        _direction, _centerX, _centerY, _tilesWidth, _tilesHeight, _leftX, _rightX, _bottomY, _topY);
 }
 
 void Hallway::generateFloor(float x, float y) {
@@ -136,8 +168,7 @@ void Hallway::generateFloor(float x, float y) {
     }
     
     floor->setPosition(Vec2(x, y));
-    floor->setGlobalZOrder(Constants::ZOrder::FLOOR);
-    this->addChild(floor, Constants::ZOrder::FLOOR);
+    _layers.add(floor, Constants::ZOrder::FLOOR);
     _floors.pushBack(floor);
 }
 
@@ -150,9 +181,8 @@ void Hallway::generateWall(float x, float y, int zOrder) {
     }
     
     wall->setPosition(Vec2(x, y));
-    wall->setGlobalZOrder(zOrder);
     wall->setTag(Constants::Tag::WALL);
-    this->addChild(wall, zOrder);
+    _layers.add(wall, zOrder);
     _walls.pushBack(wall);
 }
 
@@ -3,6 +3,7 @@
 
 #include "cocos2d.h"
 #include "Core/Constants.h"
+#include "Map/MapLayers.h"
 
 // 连接房间的走廊(Hallway)
 class Hallway : public cocos2d::Node {
@@ -12,7 +13,16 @@ public:
     virtual bool init() override;
     bool initWithDirection(int direction);
     
+    // 完整构建（计算边界 + 生成精灵）
     void createMap();
+    // 延迟构建：prepareLayout 只计算可行走边界，materialize 生成精灵
+    void prepareLayout();
+    void materialize();
+    bool isMaterialized() const { return _materialized; }
+    
+    // 走廊连接的两个房间（用于决定何时构建）
+    void setConnectedRooms(class Room* from, class Room* to) { _fromRoom = from; _toRoom = to; }
+    bool connects(class Room* room) const { return room && (room == _fromRoom || room == _toRoom); }
     void setCenter(float x, float y);
     void setGapSize(float gapSize);  // 设置实际空隙大小
     
@@ -30,6 +40,16 @@ public:
     // 检查玩家是否在走廊范围内
     bool isPlayerInHallway(class Player* player) const;
     
+    // 视野剔除：休眠的走廊不参与绘制
+    void setSleeping(bool sleeping);
+    bool isSleeping() const { return _sleeping; }
+    
+    // 瓦片所在的渲染层（由 MapGenerator 挂到层根节点下）
+    MapLayerSet& getLayers() { return _layers; }
+    
+    // 走廊整体包围盒（含墙壁）
+    cocos2d::Rect getBounds() const;
+    
 private:
     void generateFloor(float x, float y);
     void generateWall(float x, float y, int zOrder);
@@ -39,12 +59,17 @@ private:
     int _direction;  // UP, RIGHT, DOWN, LEFT
     int _tilesWidth;
     int _tilesHeight;
+    bool _sleeping;
+    bool _materialized;
+    class Room* _fromRoom;
+    class Room* _toRoom;
     
     // 边界坐标（左上角和右下角）
     float _leftX, _rightX, _topY, _bottomY;
     
     cocos2d::Vector<cocos2d::Sprite*> _floors;
     cocos2d::Vector<cocos2d::Sprite*> _walls;
+    MapLayerSet _layers;
 };
 
 #endif // __HALLWAY_H__
@@ -2,10 +2,13 @@
 #include "BossFloor.h"
 #include "Entities/Player/Player.h"
 #include "Hallway.h"
+#include "Utils/LeakTracker.h"
+#include "Utils/HitchDetector.h"
 #include <algorithm>
 #include <random>
 #include <ctime>
 #include <cstdlib>
+#include <chrono>
 
 USING_NS_CC;
 
@@ -24,11 +27,28 @@ MapGenerator* MapGenerator::create() {
     return nullptr;
 }
 
+MapGenerator::~MapGenerator() {
+    LEAK_TRACK_DESTROY(this);
+    for (int i = 0; i < MapLayerSet::COUNT; i++) {
+        CC_SAFE_RELEASE_NULL(_layerRoots[i]);
+    }
+}
+
 bool MapGenerator::init() {
+    for (int i = 0; i < MapLayerSet::COUNT; i++) {
+        _layerRoots[i] = nullptr;
+    }
+    LEAK_TRACK_CREATE(this);
+    
     if (!Node::init()) {
         return false;
     }
     
+    for (int i = 0; i < MapLayerSet::COUNT; i++) {
+        _layerRoots[i] = Node::create();
+        _layerRoots[i]->retain();
+    }
+    
     for (int y = 0; y < Constants::MAP_GRID_SIZE; y++) {
         for (int x = 0; x < Constants::MAP_GRID_SIZE; x++) {
             _roomMatrix[x][y] = nullptr;
@@ -57,6 +77,8 @@ void MapGenerator::generateMap() {
     // Boss层特殊处理：只生成起始房间+Boss房间
     if (_isBossFloor) {
         generateBossFloor();
+        attachMapLayers();
+        queueMaterialization(_beginRoom);
         return;
     }
     
@@ -68,27 +90,19 @@ void MapGenerator::generateMap() {
     assignRoomTypes();
     connectAdjacentRooms();
     
-    // 先创建房间地图（确保房间尺寸已根据类型调整）
+    // 先计算房间布局（确保房间尺寸已根据类型调整），精灵延迟到玩家接近时再构建
     for (int y = 0; y < Constants::MAP_GRID_SIZE; y++) {
         for (int x = 0; x < Constants::MAP_GRID_SIZE; x++) {
             Room* room = _roomMatrix[x][y];
             if (room) {
-                room->createMap();
+                room->prepareLayout();
                 this->addChild(room);
-                // 普通战斗房间应用随机地形布局
+                // 普通战斗房间使用随机地形布局（构建完成时应用）
+                // 奖励房间的宝箱、终点房间的传送门同样在构建完成时生成
+                // boss房间不生成传送门，由GameScene生成boss
                 if (room->getRoomType() == Constants::RoomType::NORMAL) {
-                    TerrainLayout layout = pickRandomTerrainLayout();
-                    room->applyTerrainLayout(layout);
-                }
-                // 奖励房间生成宝箱
-                else if (room->getRoomType() == Constants::RoomType::REWARD) {
-                    room->createChest();
-                }
-                // 终点房间生成传送门
-                else if (room->getRoomType() == Constants::RoomType::END) {
-                    room->createPortal();
+                    room->setTerrainLayout(pickRandomTerrainLayout());
                 }
-                // boss房间不生成传送门，由GameScene生成boss
             }
         }
     }
@@ -98,15 +112,35 @@ void MapGenerator::generateMap() {
     
     // 添加走廊到场景
     for (auto hallway : _hallways) {
-        hallway->createMap();
+        hallway->prepareLayout();
         this->addChild(hallway);
     }
     
+    attachMapLayers();
+    
     _currentRoom = _beginRoom;
+    queueMaterialization(_beginRoom);
     
     log("MapGenerator: Generated %d rooms and %d hallways", _roomCount, static_cast<int>(_hallways.size()));
 }
 
+// 遍历整棵子树：Boss层的三阶段房间不一定在房间矩阵中
+static void attachLayersRecursive(Node* node, Node* const roots[MapLayerSet::COUNT]) {
+    for (auto child : node->getChildren()) {
+        if (auto room = dynamic_cast<Room*>(child)) {
+            room->getLayers().attachTo(roots);
+        } else if (auto hallway = dynamic_cast<Hallway*>(child)) {
+            hallway->getLayers().attachTo(roots);
+        } else {
+            attachLayersRecursive(child, roots);
+        }
+    }
+}
+
+void MapGenerator::attachMapLayers() {
+    attachLayersRecursive(this, _layerRoots);
+}
+
 // 随机选择普通战斗房间地形布局（概率：空10%，其余各9%）
 TerrainLayout MapGenerator::pickRandomTerrainLayout() const {
     int r = rand() % 100; // 0..99
@@ -336,6 +370,7 @@ void MapGenerator::generateHallways() {
                         Hallway* hallway = Hallway::create(Constants::DIR_RIGHT);
                         hallway->setGapSize(gapSize);
                         hallway->setCenter(hallwayCenterX, hallwayCenterY);
+                        hallway->setConnectedRooms(room, rightRoom);
                         _hallways.push_back(hallway);
                         log("Generated RIGHT hallway at (%.1f, %.1f) gap=%.1f connecting (%d,%d) -> (%d,%d)",
                             hallwayCenterX, hallwayCenterY, gapSize, x, y, toX, toY);
@@ -370,6 +405,7 @@ void MapGenerator::generateHallways() {
                         Hallway* hallway = Hallway::create(Constants::DIR_DOWN);
                         hallway->setGapSize(gapSize);
                         hallway->setCenter(hallwayCenterX, hallwayCenterY);
+                        hallway->setConnectedRooms(room, downRoom);
                         _hallways.push_back(hallway);
                         log("Generated DOWN hallway at (%.1f, %.1f) gap=%.1f connecting (%d,%d) -> (%d,%d)",
                             hallwayCenterX, hallwayCenterY, gapSize, x, y, toX, toY);
@@ -403,6 +439,9 @@ Room* MapGenerator::updatePlayerRoom(Player* player) {
                     _currentRoom = room;
                     room->setVisited(true);
                     
+                    // 确保当前房间已构建完成，并预构建相邻房间
+                    queueMaterialization(room);
+                    
                     if (!room->allEnemiesKilled()) {
                         room->closeDoors();
                     }
@@ -447,6 +486,71 @@ Hallway* MapGenerator::getPlayerHallway(Player* player) {
     return nullptr;
 }
 
+void MapGenerator::queueMaterialization(Room* room) {
+    if (!room) return;
+    
+    // 玩家所在房间必须立即可用（碰撞、地刺、交互都依赖房间内容）
+    {
+        HitchScope scope("materializeRoom");
+        room->materializeAll();
+    }
+    _pendingRooms.erase(std::remove(_pendingRooms.begin(), _pendingRooms.end(), room), _pendingRooms.end());
+    
+    for (int dir = 0; dir < Constants::DIR_COUNT; dir++) {
+        if (!room->hasDoor(dir)) continue;
+        Room* neighbor = getRoom(room->getGridX() + DIR_DX[dir], room->getGridY() + DIR_DY[dir]);
+        if (!neighbor || neighbor->isMaterialized()) continue;
+        if (std::find(_pendingRooms.begin(), _pendingRooms.end(), neighbor) == _pendingRooms.end()) {
+            _pendingRooms.push_back(neighbor);
+        }
+    }
+    
+    for (auto hallway : _hallways) {
+        if (!hallway || hallway->isMaterialized() || !hallway->connects(room)) continue;
+        if (std::find(_pendingHallways.begin(), _pendingHallways.end(), hallway) == _pendingHallways.end()) {
+            _pendingHallways.push_back(hallway);
+        }
+    }
+}
+
+void MapGenerator::updateMaterialization() {
+    if (_pendingRooms.empty() && _pendingHallways.empty()) return;
+    
+    auto start = std::chrono::steady_clock::now();
+    auto budget = std::chrono::duration<float, std::milli>(MATERIALIZE_BUDGET_MS);
+    
+    while (std::chrono::steady_clock::now() - start < budget) {
+        // 走廊较小，优先整体构建
+        if (!_pendingHallways.empty()) {
+            _pendingHallways.front()->materialize();
+            _pendingHallways.erase(_pendingHallways.begin());
+        } else if (!_pendingRooms.empty()) {
+            if (_pendingRooms.front()->materializeStep()) {
+                _pendingRooms.erase(_pendingRooms.begin());
+            }
+        } else {
+            break;
+        }
+    }
+}
+
+void MapGenerator::updateVisibility(const Rect& viewRect) {
+    for (int y = 0; y < Constants::MAP_GRID_SIZE; y++) {
+        for (int x = 0; x < Constants::MAP_GRID_SIZE; x++) {
+            Room* room = _roomMatrix[x][y];
+            if (room) {
+                room->setSleeping(!viewRect.intersectsRect(room->getBounds()));
+            }
+        }
+    }
+    
+    for (auto hallway : _hallways) {
+        if (hallway) {
+            hallway->setSleeping(!viewRect.intersectsRect(hallway->getBounds()));
+        }
+    }
+}
+
 std::vector<Room*> MapGenerator::getAllRooms() const {
     std::vector<Room*> rooms;
     for (int y = 0; y < Constants::MAP_GRID_SIZE; y++) {
@@ -474,6 +578,8 @@ void MapGenerator::clearMap() {
         hallway->removeFromParent();
     }
     _hallways.clear();
+    _pendingRooms.clear();
+    _pendingHallways.clear();
     
     _roomCount = 0;
     _beginRoom = nullptr;
@@ -11,7 +11,11 @@
 // 地图生成器：使用BFS算法随机生成Roguelike风格的房间布局
 class MapGenerator : public cocos2d::Node {
 public:
+    // 每帧用于构建房间精灵的时间预算（毫秒）
+    static constexpr float MATERIALIZE_BUDGET_MS = 2.0f;
+    
     static MapGenerator* create();
+    virtual ~MapGenerator();
     
     virtual bool init() override;
     virtual void update(float delta) override;
@@ -58,9 +62,22 @@ public:
     // 获取所有走廊
     const std::vector<Hallway*>& getAllHallways() const { return _hallways; }
     
+    // 视野剔除：与可见区域（_gameLayer 坐标）不相交的房间和走廊进入休眠
+    void updateVisibility(const cocos2d::Rect& viewRect);
+    
+    // 延迟构建：立即完成指定房间，并把与其相邻的房间和走廊加入构建队列
+    void queueMaterialization(Room* room);
+    
+    // 在时间预算内推进构建队列（每帧由 GameScene 调用）
+    void updateMaterialization();
+    
     // 清理地图
     void clearMap();
     
+    // 渲染层根节点：由 GameScene 以 MapLayerSet::rootZOrder 挂到游戏层下
+    // 所有房间和走廊的同层瓦片都挂在同一个根节点下，按层连续绘制
+    cocos2d::Node* getLayerRoot(int layer) const { return _layerRoots[layer]; }
+    
 private:
     // BFS随机生成房间
     void randomGenerate(int startX, int startY);
@@ -80,6 +97,9 @@ private:
     // 生成Boss层地图，具体实现请查看BossFloor.cpp/h
     void generateBossFloor();
     
+    // 把所有房间和走廊的渲染层挂到层根节点下
+    void attachMapLayers();
+    
     // 随机选择普通战斗房间地形布局（概率：空10%，其余各9%）
     TerrainLayout pickRandomTerrainLayout() const;
     
@@ -90,6 +110,10 @@ private:
     // 走廊容器
     std::vector<Hallway*> _hallways;
     
+    // 待构建的房间和走廊（按加入顺序构建）
+    std::vector<Room*> _pendingRooms;
+    std::vector<Hallway*> _pendingHallways;
+    
     // 房间计数
     int _roomCount;
     
@@ -103,6 +127,9 @@ private:
     
     // 是否为Boss层
     bool _isBossFloor;
+    
+    // 渲染层根节点（retain）
+    cocos2d::Node* _layerRoots[MapLayerSet::COUNT];
 };
 
 #endif // __MAP_GENERATOR_H__
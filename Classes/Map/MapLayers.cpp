@@ -0,0 +1,79 @@
+﻿#include "MapLayers.h"
+
+USING_NS_CC;
+
+MapLayerSet::MapLayerSet()
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        _nodes[i] = Node::create();
+        _nodes[i]->retain();
+    }
+}
+
+MapLayerSet::~MapLayerSet()
+{
+    // 层节点挂在层根节点下，所属房间/走廊销毁时一并摘除
+    for (int i = 0; i < COUNT; i++)
+    {
+        _nodes[i]->removeFromParent();
+        CC_SAFE_RELEASE_NULL(_nodes[i]);
+    }
+}
+
+void MapLayerSet::add(Node* node, int zOrder)
+{
+    if (!node) return;
+    _nodes[layerForZOrder(zOrder)]->addChild(node, zOrder);
+}
+
+void MapLayerSet::attachTo(Node* const roots[COUNT])
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        if (roots[i] && _nodes[i]->getParent() == nullptr)
+        {
+            roots[i]->addChild(_nodes[i]);
+        }
+    }
+}
+
+void MapLayerSet::setVisible(bool visible)
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        _nodes[i]->setVisible(visible);
+    }
+}
+
+void MapLayerSet::moveBy(float dx, float dy)
+{
+    for (int i = 0; i < COUNT; i++)
+    {
+        for (auto child : _nodes[i]->getChildren())
+        {
+            Vec2 pos = child->getPosition();
+            child->setPosition(pos.x + dx, pos.y + dy);
+        }
+    }
+}
+
+int MapLayerSet::layerForZOrder(int zOrder)
+{
+    if (zOrder >= Constants::ZOrder::WALL_ABOVE) return WALL_ABOVE;
+    if (zOrder >= Constants::ZOrder::ITEMS) return ITEMS;
+    if (zOrder >= Constants::ZOrder::WALL_BELOW) return WALL_BELOW;
+    return FLOOR;
+}
+
+int MapLayerSet::rootZOrder(int layer)
+{
+    switch (layer)
+    {
+        case FLOOR: return Constants::ZOrder::FLOOR;
+        case WALL_BELOW: return Constants::ZOrder::WALL_BELOW;
+        case ITEMS: return Constants::ZOrder::ITEMS;
+        case WALL_ABOVE: return Constants::ZOrder::WALL_ABOVE;
+        default: return Constants::ZOrder::FLOOR;
+    }
+}
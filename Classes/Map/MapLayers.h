@@ -0,0 +1,46 @@
+﻿#ifndef __MAP_LAYERS_H__
+#define __MAP_LAYERS_H__
+
+#include "cocos2d.h"
+#include "Core/Constants.h"
+
+// 地图渲染层 - 房间/走廊的瓦片不再挂在自身节点下，而是按层挂到 MapGenerator 的层根节点下
+// 层根节点是游戏层的直接子节点，按局部 Z 序排列：地板 < 下方墙 < 物件 < (实体/子弹) < 上方墙 < (特效)
+// 同一层的所有瓦片连续绘制，同纹理可自动合批，不需要全局 Z 序
+class MapLayerSet {
+public:
+    enum Layer {
+        FLOOR = 0,      // 地板、门（打开）、地刺、宝箱、传送门
+        WALL_BELOW,     // 玩家下方的墙
+        ITEMS,          // 道具掉落物
+        WALL_ABOVE,     // 玩家上方的墙、关闭的门、箱子、柱子
+        COUNT
+    };
+    
+    MapLayerSet();
+    ~MapLayerSet();
+    
+    // 按原有的 ZOrder 值选择所在层，并以该值作为层内的局部 Z 序
+    void add(cocos2d::Node* node, int zOrder);
+    
+    cocos2d::Node* get(int layer) const { return _nodes[layer]; }
+    
+    // 挂到层根节点下（已挂载的层不会重复添加）
+    void attachTo(cocos2d::Node* const roots[COUNT]);
+    
+    void setVisible(bool visible);
+    void moveBy(float dx, float dy);
+    
+    // ZOrder 值 -> 所在层
+    static int layerForZOrder(int zOrder);
+    // 层根节点在游戏层中的局部 Z 序
+    static int rootZOrder(int layer);
+    
+private:
+    MapLayerSet(const MapLayerSet&) = delete;
+    MapLayerSet& operator=(const MapLayerSet&) = delete;
+    
+    cocos2d::Node* _nodes[COUNT];
+};
+
+#endif // __MAP_LAYERS_H__
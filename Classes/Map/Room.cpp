@@ -14,6 +14,18 @@ USING_NS_CC;
 static const int DIR_DX[] = {0, 1, 0, -1};  // UP, RIGHT, DOWN, LEFT
 static const int DIR_DY[] = {1, 0, -1, 0};
 
+// 递归暂停/恢复子树中所有节点的动作和调度（不包括根节点自身）
+static void setChildrenPaused(Node* node, bool paused) {
+    for (auto child : node->getChildren()) {
+        if (paused) {
+            child->pause();
+        } else {
+            child->resume();
+        }
+        setChildrenPaused(child, paused);
+    }
+}
+
 Room* Room::create() {
     Room* room = new (std::nothrow) Room();
     if (room && room->init()) {
@@ -43,6 +55,14 @@ bool Room::init() {
     _doorsOpen = true;
     _visited = false;
     _enemiesSpawned = false;  // 初始化敌人生成标记
+    _sleeping = false;
+    _cleared = false;
+    _layoutReady = false;
+    _materialized = false;
+    _builtRows = 0;
+    _terrainLayout = TerrainLayout::NONE;
+    _aliveEnemyCount = 0;
+    _clearHoldCount = 0;
     _floorTextureIndex = (rand() % 5) + 1;  // 随机选择1-5号地板
     _chest = nullptr;  // 初始化宝箱指针
     // _itemDrops 是 Vector，自动初始化为空
@@ -52,16 +72,29 @@ bool Room::init() {
         _doorDirections[i] = false;
     }
     
-    this->scheduleUpdate();
     return true;
 }
 
-void Room::update(float delta) {
-    if (allEnemiesKilled() && !_doorsOpen) {
-        openDoors();
+void Room::setSleeping(bool sleeping) {
+    if (_sleeping == sleeping) return;
+    _sleeping = sleeping;
+    
+    // 不可见的节点在 visit 时直接跳过，整棵子树都不会提交绘制命令
+    this->setVisible(!sleeping);
+    _layers.setVisible(!sleeping);
+    setChildrenPaused(this, sleeping);
+    for (int i = 0; i < MapLayerSet::COUNT; i++) {
+        setChildrenPaused(_layers.get(i), sleeping);
     }
 }
 
+Rect Room::getBounds() const {
+    float tileSize = Constants::FLOOR_TILE_SIZE;
+    float width = _tilesWidth * tileSize;
+    float height = _tilesHeight * tileSize;
+    return Rect(_centerX - width / 2.0f, _centerY - height / 2.0f, width, height);
+}
+
 void Room::setCenter(float x, float y) {
     _centerX = x;
     _centerY = y;
@@ -80,6 +113,15 @@ void Room::setCenter(float x, float y) {
 }
 
 void Room::createMap() {
+    // 一次性完整构建（起始房间、Boss层等需要立即可用的房间）
+    prepareLayout();
+    materializeAll();
+}
+
+void Room::prepareLayout() {
+    if (_layoutReady) return;
+    _layoutReady = true;
+    
     // 根据房间类型调整大小
     switch (_roomType) {
         case Constants::RoomType::BOSS:
@@ -98,7 +140,44 @@ void Room::createMap() {
     }
     
     setCenter(_centerX, _centerY);
+}
+
+bool Room::materializeStep() {
+    if (_materialized) return true;
+    prepareLayout();
     
+    if (_builtRows < _tilesHeight) {
+        // 从最上面一行开始逐行构建
+        buildRow(_tilesHeight - 1 - _builtRows);
+        _builtRows++;
+        return false;
+    }
+    
+    // 瓦片全部完成后生成房间内容
+    if (_roomType == Constants::RoomType::NORMAL && _terrainLayout != TerrainLayout::NONE) {
+        applyTerrainLayout(_terrainLayout);
+    }
+    createChest();
+    createPortal();
+    
+    if (_sleeping) {
+        setChildrenPaused(this, true);
+        for (int i = 0; i < MapLayerSet::COUNT; i++) {
+            setChildrenPaused(_layers.get(i), true);
+        }
+    }
+    
+    _materialized = true;
+    GAME_LOG("Room (%d,%d) materialized", _gridX, _gridY);
+    return true;
+}
+
+void Room::materializeAll() {
+    while (!materializeStep()) {
+    }
+}
+
+void Room::buildRow(int h) {
     float tileSize = Constants::FLOOR_TILE_SIZE;
     // 对于偶数瓦片，中心在两个瓦片之间
     // 第0列瓦片中心 = centerX - tileSize * (width/2 - 0.5)
@@ -106,70 +185,66 @@ void Room::createMap() {
     float startY = _centerY + tileSize * (_tilesHeight / 2.0f - 0.5f);
     
     float curX = startX;
-    float curY = startY;
+    float curY = startY - (_tilesHeight - 1 - h) * tileSize;
     
     int doorWidth = Constants::DOOR_WIDTH;
     
-    for (int h = _tilesHeight - 1; h >= 0; h--) {
-        for (int w = 0; w < _tilesWidth; w++) {
-            bool isEdge = (h == 0 || h == _tilesHeight - 1 || w == 0 || w == _tilesWidth - 1);
+    for (int w = 0; w < _tilesWidth; w++) {
+        bool isEdge = (h == 0 || h == _tilesHeight - 1 || w == 0 || w == _tilesWidth - 1);
+        
+        if (isEdge) {
+            bool isDoor = false;
+            int doorDir = -1;
+            int doorStart, doorEnd;
             
-            if (isEdge) {
-                bool isDoor = false;
-                int doorDir = -1;
-                int doorStart, doorEnd;
-                
-                // 上方门
-                if (h == _tilesHeight - 1 && _doorDirections[Constants::DIR_UP]) {
-                    doorStart = _tilesWidth / 2 - doorWidth / 2;
-                    doorEnd = doorStart + doorWidth - 1;
-                    if (w >= doorStart && w <= doorEnd) {
-                        isDoor = true;
-                        doorDir = Constants::DIR_UP;
-                    }
+            // 上方门
+            if (h == _tilesHeight - 1 && _doorDirections[Constants::DIR_UP]) {
+                doorStart = _tilesWidth / 2 - doorWidth / 2;
+                doorEnd = doorStart + doorWidth - 1;
+                if (w >= doorStart && w <= doorEnd) {
+                    isDoor = true;
+                    doorDir = Constants::DIR_UP;
                 }
-                // 下方门
-                if (h == 0 && _doorDirections[Constants::DIR_DOWN]) {
-                    doorStart = _tilesWidth / 2 - doorWidth / 2;
-                    doorEnd = doorStart + doorWidth - 1;
-                    if (w >= doorStart && w <= doorEnd) {
-                        isDoor = true;
-                        doorDir = Constants::DIR_DOWN;
-                    }
-                }
-                // 左方门
-                if (w == 0 && _doorDirections[Constants::DIR_LEFT]) {
-                    doorStart = _tilesHeight / 2 - doorWidth / 2;
-                    doorEnd = doorStart + doorWidth - 1;
-                    if (h >= doorStart && h <= doorEnd) {
-                        isDoor = true;
-                        doorDir = Constants::DIR_LEFT;
-                    }
+            }
+            // 下方门
+            if (h == 0 && _doorDirections[Constants::DIR_DOWN]) {
+                doorStart = _tilesWidth / 2 - doorWidth / 2;
+                doorEnd = doorStart + doorWidth - 1;
+                if (w >= doorStart && w <= doorEnd) {
+                    isDoor = true;
+                    doorDir = Constants::DIR_DOWN;
                 }
-                // 右方门
-                if (w == _tilesWidth - 1 && _doorDirections[Constants::DIR_RIGHT]) {
-                    doorStart = _tilesHeight / 2 - doorWidth / 2;
-                    doorEnd = doorStart + doorWidth - 1;
-                    if (h >= doorStart && h <= doorEnd) {
-                        isDoor = true;
-                        doorDir = Constants::DIR_RIGHT;
-                    }
+            }
+            // 左方门
+            if (w == 0 && _doorDirections[Constants::DIR_LEFT]) {
+                doorStart = _tilesHeight / 2 - doorWidth / 2;
+                doorEnd = doorStart + doorWidth - 1;
+                if (h >= doorStart && h <= doorEnd) {
+                    isDoor = true;
+                    doorDir = Constants::DIR_LEFT;
                 }
-                
-                if (isDoor) {
-                    generateDoor(curX, curY, doorDir);
-                } else {
-                    int zOrder = (h == _tilesHeight - 1) ? Constants::ZOrder::WALL_BELOW : Constants::ZOrder::WALL_ABOVE;
-                    generateWall(curX, curY, zOrder);
+            }
+            // 右方门
+            if (w == _tilesWidth - 1 && _doorDirections[Constants::DIR_RIGHT]) {
+                doorStart = _tilesHeight / 2 - doorWidth / 2;
+                doorEnd = doorStart + doorWidth - 1;
+                if (h >= doorStart && h <= doorEnd) {
+                    isDoor = true;
+                    doorDir = Constants::DIR_RIGHT;
                 }
-            } else {
-                generateFloor(curX, curY);
             }
             
-            curX += tileSize;
+            if (isDoor) {
+                generateDoor(curX, curY, doorDir);
+            } else {
+                int zOrder = (h == _tilesHeight - 1) ? Constants::ZOrder::WALL_BELOW : Constants::ZOrder::WALL_ABOVE;
+                generateWall(curX, curY, zOrder);
+            }
+        } else {
+            generateFloor(curX, curY);
         }
-        curX = startX;
-        curY -= tileSize;
+        
+        curX += tileSize;
     }
 }
 
@@ -225,8 +300,7 @@ void Room::generateFloor(float x, float y) {
     }
 
     floor->setPosition(Vec2(x, y));
-    floor->setGlobalZOrder(Constants::ZOrder::FLOOR);
-    this->addChild(floor, Constants::ZOrder::FLOOR);
+    _layers.add(floor, Constants::ZOrder::FLOOR);
     _floors.pushBack(floor);
 }
 
@@ -239,9 +313,8 @@ void Room::generateWall(float x, float y, int zOrder) {
     }
     
     wall->setPosition(Vec2(x, y));
-    wall->setGlobalZOrder(zOrder);
     wall->setTag(Constants::Tag::WALL);
-    this->addChild(wall, zOrder);
+    _layers.add(wall, zOrder);
     _walls.pushBack(wall);
 }
 
@@ -255,8 +328,8 @@ void Room::generateDoor(float x, float y, int direction) {
         doorOpen->setColor(Color3B(50, 50, 70));
     }
     doorOpen->setPosition(Vec2(x, y));
-    doorOpen->setGlobalZOrder(Constants::ZOrder::DOOR);
-    this->addChild(doorOpen, Constants::ZOrder::DOOR);
+    doorOpen->setVisible(_doorsOpen);
+    _layers.add(doorOpen, Constants::ZOrder::DOOR);
     _doorsOpenSprites.pushBack(doorOpen);
     
     auto doorClosed = Sprite::create("Map/Door/Door_closed.png");
@@ -266,9 +339,11 @@ void Room::generateDoor(float x, float y, int direction) {
         doorClosed->setColor(Color3B(120, 60, 30));
     }
     doorClosed->setPosition(Vec2(x, y));
-    doorClosed->setGlobalZOrder(Constants::ZOrder::WALL_ABOVE);
-    doorClosed->setVisible(false);
-    this->addChild(doorClosed, Constants::ZOrder::WALL_ABOVE);
+    doorClosed->setVisible(!_doorsOpen);
+    if (!_doorsOpen) {
+        doorClosed->setTag(Constants::Tag::WALL);
+    }
+    _layers.add(doorClosed, Constants::ZOrder::WALL_ABOVE);
     _doorsClosedSprites.pushBack(doorClosed);
 }
 
@@ -290,8 +365,7 @@ void Room::addSpikeAtPosition(const Vec2& pos)
         return;
     }
     spike->setPosition(pos);
-    spike->setGlobalZOrder(Constants::ZOrder::FLOOR + 1);
-    this->addChild(spike, Constants::ZOrder::FLOOR + 1);
+    _layers.add(spike, Constants::ZOrder::FLOOR + 1);
     _spikes.pushBack(spike);
 }
 
@@ -309,8 +383,7 @@ void Room::addBoxAtPosition(const Vec2& pos, Box::BoxType type)
         return;
     }
     box->setPosition(pos);
-    box->setGlobalZOrder(Constants::ZOrder::WALL_ABOVE);
-    this->addChild(box, Constants::ZOrder::WALL_ABOVE);
+    _layers.add(box, Constants::ZOrder::WALL_ABOVE);
     _barriers.pushBack(box);
 }
 
@@ -328,8 +401,7 @@ void Room::addPillarAtPosition(const Vec2& pos, Pillar::PillarType type)
         return;
     }
     pillar->setPosition(pos);
-    pillar->setGlobalZOrder(Constants::ZOrder::WALL_ABOVE);
-    this->addChild(pillar, Constants::ZOrder::WALL_ABOVE);
+    _layers.add(pillar, Constants::ZOrder::WALL_ABOVE);
     _barriers.pushBack(pillar);
 }
 
@@ -359,8 +431,8 @@ void Room::createEnemies(int count) {
         auto enemy = Enemy::create();
         if (enemy) {
             enemy->setPosition(Vec2(randX, randY));
-            _enemies.pushBack(enemy);
             this->addChild(enemy);
+            registerEnemy(enemy);
         }
     }
 }
@@ -370,12 +442,66 @@ bool Room::allEnemiesKilled() const {
         return true;
     }
     
-    for (auto enemy : _enemies) {
-        if (enemy->getHP() > 0) {
-            return false;
-        }
+    return _aliveEnemyCount <= 0 && _clearHoldCount <= 0;
+}
+
+void Room::registerEnemy(Enemy* enemy) {
+    if (!enemy || enemy->isDead() || !enemy->countsForRoomClear()) {
+        return;
+    }
+    if (enemy->getClearRoom() == this) {
+        return;
+    }
+    if (_cleared) {
+        // 房间已清空后不再重新关门，迟到的敌人不计入
+        GAME_LOG("Room (%d,%d) already cleared, enemy not counted", _gridX, _gridY);
+        return;
+    }
+    
+    enemy->setClearRoom(this);
+    _enemies.pushBack(enemy);
+    _aliveEnemyCount++;
+}
+
+void Room::notifyEnemyKilled(Enemy* enemy) {
+    if (!enemy || enemy->getClearRoom() != this) {
+        return;
+    }
+    
+    enemy->setClearRoom(nullptr);
+    _enemies.eraseObject(enemy);
+    _aliveEnemyCount--;
+    checkCleared();
+}
+
+void Room::holdClear() {
+    _clearHoldCount++;
+}
+
+void Room::releaseClear() {
+    if (_clearHoldCount > 0) {
+        _clearHoldCount--;
+    }
+    checkCleared();
+}
+
+void Room::checkCleared() {
+    if (_cleared || !_enemiesSpawned) {
+        return;
+    }
+    if (_aliveEnemyCount > 0 || _clearHoldCount > 0) {
+        return;
+    }
+    
+    _cleared = true;
+    GAME_LOG("Room (%d,%d) cleared", _gridX, _gridY);
+    
+    if (!_doorsOpen) {
+        openDoors();
+    }
+    if (_clearedCallback) {
+        _clearedCallback(this);
     }
-    return true;
 }
 
 void Room::openDoors() {
@@ -437,6 +563,7 @@ void Room::moveBy(float dx, float dy) {
         Vec2 pos = child->getPosition();
         child->setPosition(pos.x + dx, pos.y + dy);
     }
+    _layers.moveBy(dx, dy);
 }
 
 bool Room::checkPlayerPosition(Player* player, float& speedX, float& speedY) {
@@ -539,8 +666,7 @@ void Room::createChest()
     
     // 放置在房间中央
     _chest->setPosition(cocos2d::Vec2(_centerX, _centerY));
-    _chest->setGlobalZOrder(Constants::ZOrder::FLOOR + 2);
-    this->addChild(_chest, Constants::ZOrder::FLOOR + 2);
+    _layers.add(_chest, Constants::ZOrder::ITEMS);
     
     GAME_LOG("Created chest at center of reward room");
 }
@@ -576,8 +702,7 @@ void Room::openChest(Player* player)
     {
         if (drop)
         {
-            _itemDrops.pushBack(drop);
-            // PS: 道具已经在 Chest::open 中被添加到父节点了，这里只需要记录引用
+            addItemDrop(drop);
             GAME_LOG("ItemDrop created in room at position (%.1f, %.1f)", drop->getPosition().x, drop->getPosition().y);
         }
     }
@@ -644,7 +769,7 @@ void Room::addItemDrop(ItemDrop* drop)
     if (drop)
     {
         _itemDrops.pushBack(drop);
-        this->addChild(drop, Constants::ZOrder::ITEMS);
+        _layers.add(drop, Constants::ZOrder::ITEMS);
     }
 }
 
@@ -667,7 +792,7 @@ void Room::createPortal()
     
     // 放置在房间中央
     _portal->setPosition(Vec2(_centerX, _centerY));
-    this->addChild(_portal, Constants::ZOrder::FLOOR + 2);
+    _layers.add(_portal, Constants::ZOrder::FLOOR + 2);
     
     GAME_LOG("Created portal at center of end room");
 }
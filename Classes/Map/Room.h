@@ -5,6 +5,7 @@
 #include "Core/Constants.h"
 #include "Map/Barriers.h"
 #include "Map/TerrainLayouts.h"  // 地形布局系统
+#include "Map/MapLayers.h"
 
 class Enemy;
 class Player;
@@ -21,10 +22,20 @@ public:
     static Room* create();
     
     virtual bool init() override;
-    virtual void update(float delta) override;
     
+    // 完整构建房间（布局 + 全部精灵 + 房间内容）
     void createMap();
     
+    // 延迟构建：prepareLayout 只计算尺寸和边界（廉价数据），精灵由 materializeStep 逐行构建
+    void prepareLayout();
+    // 构建一行瓦片（全部完成后生成地形/宝箱/传送门），返回是否已全部完成
+    bool materializeStep();
+    void materializeAll();
+    bool isMaterialized() const { return _materialized; }
+    
+    // 地形布局在生成地图时决定，构建完成时应用
+    void setTerrainLayout(TerrainLayout layout) { _terrainLayout = layout; }
+    
     void setCenter(float x, float y);
     cocos2d::Vec2 getCenter() const { return cocos2d::Vec2(_centerX, _centerY); }
     
@@ -42,7 +53,23 @@ public:
     
     void createEnemies(int count);
     bool allEnemiesKilled() const;
-    cocos2d::Vector<Enemy*>& getEnemies() { return _enemies; }
+    const cocos2d::Vector<Enemy*>& getEnemies() const { return _enemies; }
+    
+    // 清房计数（事件驱动）：敌人注册时计数+1，死亡时由 Enemy 回报计数-1
+    // 计数和延迟生成都归零时触发一次"房间清空"：开门并回调 _clearedCallback
+    void registerEnemy(Enemy* enemy);
+    void notifyEnemyKilled(Enemy* enemy);
+    
+    // 清房挂起：敌人死亡后还会延迟生成新的敌人（恐卡兹、铁枪、铁光杯）或播放收尾动画时，
+    // 先挂起，完成后再释放，避免房间在中途被判定清空
+    void holdClear();
+    void releaseClear();
+    
+    // 在敌人生成完毕后调用，处理"生成了 0 个敌人"的情况
+    void checkCleared();
+    bool isCleared() const { return _cleared; }
+    
+    void setClearedCallback(const std::function<void(Room*)>& callback) { _clearedCallback = callback; }
 
     // 地刺管理
     void addSpikeAtPosition(const cocos2d::Vec2& pos);
@@ -60,6 +87,17 @@ public:
     void closeDoors();
     bool areDoorsOpen() const { return _doorsOpen; }
     
+    // 视野剔除：休眠的房间不参与绘制，子节点动作暂停
+    // 房间本身没有逐帧逻辑，开门等状态变化由敌人死亡事件驱动，与休眠状态无关
+    void setSleeping(bool sleeping);
+    bool isSleeping() const { return _sleeping; }
+    
+    // 瓦片/宝箱/掉落物/传送门所在的渲染层（由 MapGenerator 挂到层根节点下）
+    MapLayerSet& getLayers() { return _layers; }
+    
+    // 房间整体包围盒（含墙壁，_gameLayer 坐标）
+    cocos2d::Rect getBounds() const;
+    
     bool isPlayerInRoom(Player* player) const;
     cocos2d::Rect getWalkableArea() const;
     void moveBy(float dx, float dy);
@@ -99,6 +137,7 @@ protected:
     void generateFloor(float x, float y);
     void generateWall(float x, float y, int zOrder);
     void generateDoor(float x, float y, int direction);
+    void buildRow(int h);
     
     // 将瓦片坐标转换为世界坐标
     cocos2d::Vec2 tileToWorldPos(int tileX, int tileY) const;
@@ -118,6 +157,16 @@ private:
     bool _doorsOpen;
     bool _visited;
     bool _enemiesSpawned;  // 是否已生成敌人
+    bool _sleeping;        // 是否处于视野外休眠
+    MapLayerSet _layers;   // 按渲染层拆分的精灵
+    bool _cleared;         // 是否已触发过房间清空
+    bool _layoutReady;     // 尺寸和边界是否已计算
+    bool _materialized;    // 精灵是否已全部构建
+    int _builtRows;        // 已构建的瓦片行数
+    TerrainLayout _terrainLayout;
+    int _aliveEnemyCount;  // 计入清房的存活敌人数
+    int _clearHoldCount;   // 清房挂起计数
+    std::function<void(Room*)> _clearedCallback;
     int _floorTextureIndex;  // 随机选择的地板纹理索引(1-5)
     
     cocos2d::Vector<cocos2d::Sprite*> _floors;
@@ -1,25 +1,31 @@
 ﻿#include "GameScene.h"
 #include "MainMenuScene.h"
+#include "LoadingScene.h"
+#include "UI/FloatingText.h"
+#include "Entities/Base/DamageQueue.h"
+#include "Utils/VfxShapes.h"
 #include "Entities/Player/Mage.h"
 #include "Entities/Player/Gunner.h"
 #include "Entities/Player/Warrior.h"
 #include "UI/CharacterSelectLayer.h"
-#include "Entities/Enemy/KongKaZi.h"
-#include "Entities/Enemy/DeYi.h"
-#include "Entities/Enemy/Ayao.h"
+#include "Entities/Enemy/KuiLongBoss.h"
 #include "Entities/Enemy/XinXing.h"
 #include "Entities/Enemy/TangHuang.h"
-#include "Entities/Enemy/Du.h"
-#include "Entities/Enemy/Cup.h"
-#include "Entities/Enemy/Boat.h"
-#include "Entities/Enemy/KuiLongBoss.h"
 #include "Entities/Objects/Chest.h"
 #include "Entities/Objects/ItemDrop.h"
 #include "Entities/Objects/Portal.h"
 #include "ui/CocosGUI.h"
 #include "audio/include/AudioEngine.h"
 #include "Managers/SoundManager.h"
+#include "Managers/TextureBudget.h"
+#include "Utils/LeakTracker.h"
+#include "Utils/GameMetrics.h"
+#include "Utils/TimerWheel.h"
+#include "Utils/HitchDetector.h"
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
 #include "Map/Room.h"
 
 // 静态变量定义
@@ -34,6 +40,30 @@ Scene* GameScene::createScene()
     return GameScene::create();
 }
 
+GameScene::GameScene()
+    : _aiFrame(0)
+    , _simulationSuspended(false)
+    , _buildStage(BuildStage::MAP)
+    , _stagedBuild(false)
+    , _prefetchLoader(nullptr)
+    , _nextScene(nullptr)
+    , _prefetchLevel(0)
+    , _prefetchStage(0)
+    , _leakGeneration(LeakTracker::beginGeneration())
+{
+    LEAK_TRACK_CREATE(this);
+}
+
+GameScene::~GameScene()
+{
+    CC_SAFE_RELEASE_NULL(_prefetchLoader);
+    CC_SAFE_RELEASE_NULL(_nextScene);
+    
+    // 子节点在基类析构中释放，延迟检查本代对象是否全部销毁
+    LEAK_TRACK_DESTROY(this);
+    LeakTracker::endGeneration(_leakGeneration);
+}
+
 bool GameScene::init()
 {
     if (!Scene::init())
@@ -41,13 +71,10 @@ bool GameScene::init()
         return false;
     }
     
-    // 预加载所有玩家音效（在场景初始化最开始，给足时间加载）
-    SoundManager::getInstance()->preload("SoundEffect/Nymph_Attack.mp3");
-    SoundManager::getInstance()->preload("SoundEffect/Nymph_Skill_Attack.mp3");
-    SoundManager::getInstance()->preload("SoundEffect/Wisdael_Attack.mp3");
-    SoundManager::getInstance()->preload("SoundEffect/Wisdael_Skill_Attack.mp3");
-    SoundManager::getInstance()->preload("SoundEffect/MudRock_Attack.mp3");
-    SoundManager::getInstance()->preload("SoundEffect/MudRock_Skill_Attack.mp3");
+    // 纹理与音效已由 LoadingScene 按关卡清单预加载
+    FloatingText::prewarm(32);
+    VfxShapes::prewarm(16);
+    HitchDetector::install();
     
     _isPaused = false;
     _isGameOver = false;
@@ -76,14 +103,174 @@ bool GameScene::init()
     s_savedMP = 0;
     s_savedItems.clear();
     
-    initLayers();
-    initMapSystem();    // 初始化地图系统
-    createPlayer();
-    initCamera();       // 初始化相机
-    // createTestEnemies();  // 敌人由房间生成，不再单独创建
-    createHUD();
+    // 预建的下一关由上一层逐帧推进构建
+    if (!_stagedBuild)
+    {
+        advanceBuild(0.0f);
+    }
+    
+    return true;
+}
+
+GameScene* GameScene::createStaged()
+{
+    GameScene* scene = new (std::nothrow) GameScene();
+    if (scene)
+    {
+        scene->_stagedBuild = true;
+        if (scene->init())
+        {
+            scene->autorelease();
+            return scene;
+        }
+    }
+    CC_SAFE_DELETE(scene);
+    return nullptr;
+}
+
+bool GameScene::advanceBuild(float budgetMs)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (_buildStage != BuildStage::DONE)
+    {
+        float remainingMs = 0.0f;
+        if (budgetMs > 0.0f)
+        {
+            remainingMs = budgetMs - std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        
+        switch (_buildStage)
+        {
+            case BuildStage::MAP:
+                initLayers();
+                initMapSystem();    // 初始化地图系统
+                initEnemyPool();    // 按本关房间设置敌人预留目标
+                _buildStage = BuildStage::ENEMY_POOL;
+                break;
+            case BuildStage::ENEMY_POOL:
+                // 预热敌人（构建期完成，战斗帧不再创建）
+                if (!_enemyPool.prewarm(remainingMs)) return false;
+                _buildStage = BuildStage::PLAYER;
+                break;
+            case BuildStage::PLAYER:
+                createPlayer();
+                initCamera();       // 初始化相机
+                // createTestEnemies();  // 敌人由房间生成，不再单独创建
+                createHUD();
+                _buildStage = BuildStage::UI;
+                break;
+            case BuildStage::UI:
+                // 恢复上一关收集的道具与血蓝量（预建场景在 applyCarryOver 中恢复）
+                if (!_stagedBuild)
+                {
+                    restoreCarryOverState();
+                }
+                createMenus();
+                setupKeyboardListener();
+                
+                // 开启update（未进入场景前调度处于暂停状态）
+                scheduleUpdate();
+                _buildStage = BuildStage::DONE;
+                GAME_LOG("GameScene initialized");
+                break;
+            case BuildStage::DONE:
+                break;
+        }
+        
+        if (budgetMs > 0.0f && _buildStage != BuildStage::DONE
+            && std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void GameScene::applyCarryOver(int hp, int mp, const std::vector<std::string>& items)
+{
+    _savedHP = hp;
+    _savedMP = mp;
+    _collectedItems = items;
+    restoreCarryOverState();
+}
+
+void GameScene::onEnter()
+{
+    Scene::onEnter();
+    
+    // 播放战斗音乐（放在 onEnter：预取的场景在后台构建时不能切换当前音乐）
+    if (_currentStage == 0)
+    {
+        // Boss战斗音乐
+        SoundManager::getInstance()->playBGM("Music/Boss_Battle.mp3", true);
+        GAME_LOG("Playing Boss battle music");
+    }
+    else
+    {
+        // 普通战斗音乐
+        SoundManager::getInstance()->playBGM("Music/Game_Battle.mp3", true);
+        GAME_LOG("Playing normal battle music");
+    }
+}
+
+void GameScene::onEnterTransitionDidFinish()
+{
+    Scene::onEnterTransitionDidFinish();
+    
+    // 过渡动画期间上一场景仍持有其纹理；过渡结束时它才被移出，
+    // 自动释放池在本帧末尾释放它，下一帧再清理上一楼层遗留的纹理
+    this->scheduleOnce([](float) {
+        TextureBudget::getInstance()->trimForLevel();
+    }, 0.0f, "texture_trim");
+}
+
+void GameScene::onExit()
+{
+    // 离开场景时放弃尚未使用的预取
+    cancelNextLevelPrefetch();
+    _enemyPool.clear();
+    suspendSimulation();
+    Scene::onExit();
+}
+
+void GameScene::initEnemyPool()
+{
+    // 普通房间：按生成权重为单个房间的上限预留（逐房间推进，离开战斗后再补齐）
+    _enemyPool.addWeightedTarget(&EnemyTraits::roomSpawnWeight, EnemyPool::ROOM_ENEMY_BUDGET);
+    // 红色标记死亡生成的恐卡兹（30% 概率）
+    _enemyPool.addTarget(EnemyKind::KONGKAZI, static_cast<int>(std::ceil(EnemyPool::ROOM_ENEMY_BUDGET * 0.3f)));
+    
+    // Boss 层：初始小怪 + 各阶段召唤
+    bool hasBossRoom = false;
+    if (_mapGenerator)
+    {
+        for (auto room : _mapGenerator->getAllRooms())
+        {
+            if (room && room->getRoomType() == Constants::RoomType::BOSS)
+            {
+                hasBossRoom = true;
+                break;
+            }
+        }
+    }
+    if (hasBossRoom)
+    {
+        _enemyPool.addWeightedTarget(&EnemyTraits::bossSpawnWeight, EnemyPool::BOSS_MINION_BUDGET);
+        KuiLongBoss::reserveMinions(_enemyPool);
+    }
     
-    // 恢复上一关收集的道具
+    // 死亡动画结束后生成的铁枪 / 铁光杯，按母体的预留数补足
+    _enemyPool.addTarget(EnemyKind::IRON_LANCE, _enemyPool.getTarget(EnemyKind::XINXING) * XinXing::IRON_LANCE_COUNT);
+    _enemyPool.addTarget(EnemyKind::IRON_LIGHT_CUP, _enemyPool.getTarget(EnemyKind::TANGHUANG) * TangHuang::IRON_LIGHT_CUP_COUNT);
+}
+
+Enemy* GameScene::acquireEnemy(EnemyKind kind)
+{
+    return _enemyPool.acquire(kind);
+}
+
+void GameScene::restoreCarryOverState()
+{
     if (!_collectedItems.empty())
     {
         GAME_LOG("Restoring %d items from previous level", (int)_collectedItems.size());
@@ -120,30 +307,6 @@ bool GameScene::init()
         _player->setMP(_savedMP);
         GAME_LOG("Restored player HP: %d, MP: %d (after item effects)", _savedHP, _savedMP);
     }
-    
-    createMenus();
-    setupKeyboardListener();
-    
-    // 开启update
-    scheduleUpdate();
-    
-    // 播放战斗音乐
-    if (_currentStage == 0)
-    {
-        // Boss战斗音乐
-        SoundManager::getInstance()->playBGM("Music/Boss_Battle.mp3", true);
-        GAME_LOG("Playing Boss battle music");
-    }
-    else
-    {
-        // 普通战斗音乐
-        SoundManager::getInstance()->playBGM("Music/Game_Battle.mp3", true);
-        GAME_LOG("Playing normal battle music");
-    }
-    
-    GAME_LOG("GameScene initialized");
-    
-    return true;
 }
 
 void GameScene::initLayers()
@@ -155,8 +318,8 @@ void GameScene::initLayers()
     auto background = LayerColor::create(Color4B(20, 60, 30, 255));
     this->addChild(background, -1);
     
-    // 游戏层
-    _gameLayer = Layer::create();
+    // 游戏层（实体按 Y 坐标排序，决定玩家与敌人的遮挡关系）
+    _gameLayer = YSortLayer::create();
     this->addChild(_gameLayer, Constants::ZOrder::ENTITY);
     
     // UI层
@@ -176,7 +339,21 @@ void GameScene::initMapSystem()
     }
     
     _mapGenerator->generateMap();
-    _gameLayer->addChild(_mapGenerator);
+    _gameLayer->addChild(_mapGenerator, Constants::ZOrder::FLOOR);
+    
+    // 地图渲染层根节点：同层瓦片连续绘制，实体/子弹/特效按局部 Z 序穿插在各层之间
+    for (int i = 0; i < MapLayerSet::COUNT; i++)
+    {
+        _gameLayer->addChild(_mapGenerator->getLayerRoot(i), MapLayerSet::rootZOrder(i));
+    }
+    
+    // 注册房间清空事件
+    for (auto room : _mapGenerator->getAllRooms())
+    {
+        room->setClearedCallback([this](Room* clearedRoom) {
+            onRoomCleared(clearedRoom);
+        });
+    }
     
     // 创建小地图
     _miniMap = MiniMap::create();
@@ -267,6 +444,12 @@ void GameScene::updateCamera(float dt)
     newPos.y = currentPos.y + (targetY - currentPos.y) * smoothFactor;
     
     _gameLayer->setPosition(newPos);
+    
+    // 视野剔除：游戏层偏移的反向即为可见区域在游戏层中的原点，外扩一格防止边缘闪烁
+    float margin = Constants::FLOOR_TILE_SIZE;
+    Rect viewRect(-newPos.x - margin, -newPos.y - margin,
+                  visibleSize.width + margin * 2, visibleSize.height + margin * 2);
+    _mapGenerator->updateVisibility(viewRect);
 }
 
 void GameScene::createPlayer()
@@ -318,10 +501,7 @@ void GameScene::createPlayer()
                  SCREEN_CENTER.x, SCREEN_CENTER.y);
     }
     
-    // 设置玩家的全局Z顺序
-    _player->setGlobalZOrder(Constants::ZOrder::ENTITY);
-    
-    _gameLayer->addChild(_player);
+    _gameLayer->addChild(_player, Constants::ZOrder::ENTITY);
 }
 
 void GameScene::createTestEnemies()
@@ -343,7 +523,7 @@ void GameScene::createTestEnemies()
         enemySprite->addChild(drawNode);
         enemy->bindSprite(enemySprite);
         
-        _gameLayer->addChild(enemy);
+        _gameLayer->addChild(enemy, Constants::ZOrder::ENTITY);
         _enemies.pushBack(enemy);
         
         // 测试红色标记
@@ -373,6 +553,9 @@ void GameScene::spawnEnemiesInRoom(Room* room)
     // 标记已生成敌人
     room->setEnemiesSpawned(true);
     
+    // 卡顿归因：敌人首次生成时会同步解码纹理、创建 Label
+    HitchScope spawnScope("spawnEnemiesInRoom");
+    
     // 关闭房间的门
     room->closeDoors();
     
@@ -385,6 +568,7 @@ void GameScene::spawnEnemiesInRoom(Room* room)
     // Boss房间：只生成一个Boss在中心
     if (room->getRoomType() == Constants::RoomType::BOSS)
     {
+        HitchScope bossScope("spawnEnemy", "KuiLongBoss");
         auto boss = KuiLongBoss::create();
         if (boss)
         {
@@ -407,17 +591,14 @@ void GameScene::spawnEnemiesInRoom(Room* room)
         }
 
         // 2.1: Boss房间初始会生成30个怪，怪物只包含妒，阿咬，魂灵圣杯和堂皇。
-        int initialMinions = 30;
+        int initialMinions = EnemyPool::BOSS_MINION_BUDGET;
         for (int i = 0; i < initialMinions; ++i) {
-            Enemy* minion = nullptr;
-            float r = CCRANDOM_0_1();
-            // 四种怪物均分概率 (各25%)
-            if (r < 0.25f) minion = Du::create();
-            else if (r < 0.50f) minion = Ayao::create();
-            else if (r < 0.75f) minion = Cup::create();
-            else minion = TangHuang::create();
+            HitchScope minionScope("spawnEnemy");
+            // 四种怪物均分概率 (各25%，见 EnemyKinds::TABLE 的 Boss 权重)
+            Enemy* minion = acquireEnemy(EnemyKinds::pickBossSpawn(CCRANDOM_0_1()));
 
             if (minion) {
+                minionScope.setDetail(minion->getTraits().name);
                 // 在可行走区域内随机生成
                 float x = walk.origin.x + CCRANDOM_0_1() * walk.size.width;
                 float y = walk.origin.y + CCRANDOM_0_1() * walk.size.height;
@@ -425,43 +606,23 @@ void GameScene::spawnEnemiesInRoom(Room* room)
                 addEnemy(minion);
             }
         }
+        room->checkCleared();
         return; 
     }
 
     // 随机生成3-8个怪
-    int enemyCount = RANDOM_INT(3, 8);
+    int enemyCount = RANDOM_INT(3, EnemyPool::ROOM_ENEMY_BUDGET);
 
     for (int i = 0; i < enemyCount; i++)
     {
-        Enemy* enemy = nullptr;
-        float r = CCRANDOM_0_1();
+        HitchScope enemyScope("spawnEnemy");
         // 目标：Cup + Du 合计 30%，其余 70% 平均给 Ayao/DeYi/XinXing/TangHuang（每个 17.5%）
-        if (r < 0.30f)
-        {
-            // 在 30% 区间内等概率选择 Cup 或 Du（各 ~15%）
-            float r2 = CCRANDOM_0_1();
-            if (r2 < 0.5f) {
-                enemy = Cup::create();
-            } else {
-                enemy = Du::create();
-            }
-        }
-        else
-        {
-            // 将剩余区间归一化为 0..1，平均分 4 份
-            float r2 = (r - 0.30f) / 0.70f; // 0..1
-            if (r2 < 0.25f) {
-                enemy = Ayao::create();
-            } else if (r2 < 0.50f) {
-                enemy = DeYi::create();
-            } else if (r2 < 0.75f) {
-                enemy = XinXing::create();
-            } else {
-                enemy = TangHuang::create();
-            }
-        }
+        // 权重见 EnemyKinds::TABLE
+        Enemy* enemy = acquireEnemy(EnemyKinds::pickRoomSpawn(CCRANDOM_0_1()));
 
         if (!enemy) continue;
+        const char* typeName = enemy->getTraits().name;
+        enemyScope.setDetail(typeName);
 
         // PS: walk 是绝对坐标，直接采样
         // 在 walk 可行走区域内随机位置
@@ -486,16 +647,11 @@ void GameScene::spawnEnemiesInRoom(Room* room)
         // 尝试应用红色标记（30%）
         enemy->tryApplyRedMark(0.3f);
 
-        const char* typeName = "Unknown";
-        if (dynamic_cast<Ayao*>(enemy)) typeName = "Ayao";
-        else if (dynamic_cast<DeYi*>(enemy)) typeName = "DeYi";
-        else if (dynamic_cast<XinXing*>(enemy)) typeName = "XinXing";
-        else if (dynamic_cast<TangHuang*>(enemy)) typeName = "TangHuang";
-        else if (dynamic_cast<Du*>(enemy)) typeName = "Du";
-        else if (dynamic_cast<Cup*>(enemy)) typeName = "Cup"; // 新增：Cup 的类型名
-
         GAME_LOG("Enemy spawned at (%.1f, %.1f) in room - type=%s", spawnPos.x, spawnPos.y, typeName);
     }
+    
+    // 全部生成失败时直接判定清空，避免门永远关闭
+    room->checkCleared();
 }
 
 void GameScene::createHUD()
@@ -527,11 +683,13 @@ void GameScene::createMenus()
     });
     
     _gameMenus->setRestartCallback([this]() {
-        auto newScene = GameScene::createScene();
-        Director::getInstance()->replaceScene(TransitionFade::create(0.5f, newScene));
+        suspendSimulation();
+        auto loadingScene = LoadingScene::createScene();
+        Director::getInstance()->replaceScene(TransitionFade::create(0.5f, loadingScene));
     });
     
     _gameMenus->setMainMenuCallback([this]() {
+        suspendSimulation();
         auto menuScene = MainMenuScene::createScene();
         Director::getInstance()->replaceScene(TransitionFade::create(0.5f, menuScene));
     });
@@ -548,19 +706,104 @@ void GameScene::update(float dt)
     
     Scene::update(dt);
     
+    // 实体阶段：状态 → AI → 移动 → 碰撞 → 伤害 → 清理
+    TimerWheel::getInstance()->tick(dt);  // 延迟回调（暂停时不推进）
+    updateEntitySystems(dt);  // 状态效果与计时器
+    updateEnemies(dt);        // 敌人 AI
+    updateEntities(dt);       // 实体自身逻辑与移动
+    checkBarrierCollisions(); // 检测障碍物碰撞
+    checkCollisions();
+    updateSpikes(dt);         // 更新地刺伤害
+    GameMetrics::recordDamage(DamageQueue::getInstance()->resolve());  // 结算本帧排队的伤害
+    resolveDeaths();
+    removeDeadEnemies();
+    
+    // 回收已播完死亡收尾的敌人；没有存活敌人时才在时间预算内补齐预留（战斗中不创建敌人）
+    _enemyPool.reclaim();
+    if (_enemies.empty())
+    {
+        _enemyPool.prewarm(EnemyPool::REFILL_BUDGET_MS);
+    }
+    
     updatePlayer(dt);
     updateCamera(dt);     // 更新相机位置
     updateMapSystem(dt);  // 更新地图系统
-    updateEnemies(dt);
-    updateSpikes(dt);     // 更新地刺伤害
     updateInteraction(dt); // 更新交互提示
     updateHUD(dt);
-    checkBarrierCollisions(); // 检测障碍物碰撞
-    checkCollisions();
+    updateNextLevelBuild();  // 终点房间中逐帧构建下一关
+    
+    // 运行时指标（仅在调试构建按 F8 开启后每帧记录计数、按间隔遍历场景树，HUD 调试面板在下一次限频刷新时读取）
+    GameMetrics::sample(this, dt);
+}
+
+void GameScene::updateEntitySystems(float dt)
+{
+    auto store = EntityStore::getInstance();
+    store->syncTransforms();
+    if (_player)
+    {
+        store->updateBlackboards(_player->getPositionX(), _player->getPositionY());
+    }
+    store->tickTimers(dt);
+    
+    _statusEvents.clear();
+    store->tickStatus(dt, _statusEvents);
+    
+    // 回放期间可能有敌人死亡被移除，先全部持有再逐个回放
+    for (auto& event : _statusEvents) event.view->retain();
+    for (auto& event : _statusEvents)
+    {
+        if (event.damage > 0)
+        {
+            event.view->onStatusDamage(event.damage, event.damageType);
+        }
+        if (event.expired)
+        {
+            event.view->onStatusExpired();
+        }
+    }
+    for (auto& event : _statusEvents) event.view->release();
+}
+
+void GameScene::updateEntities(float dt)
+{
+    auto store = EntityStore::getInstance();
+    _tickEntities.clear();
+    store->collectTicking(_tickEntities);
+    
+    // 实体更新中可能移除/销毁其他实体，先全部持有；
+    // 本阶段新建的实体从下一帧开始更新
+    for (auto entity : _tickEntities) entity->retain();
+    for (auto entity : _tickEntities)
+    {
+        // 可能已被前面的实体移出场景或停止更新
+        int slot = entity->getStoreSlot();
+        if (entity->isRunning() && store->isTicking(slot))
+        {
+            entity->update(dt);
+        }
+    }
+    for (auto entity : _tickEntities) entity->release();
+}
+
+void GameScene::resolveDeaths()
+{
+    _deadEntities.clear();
+    EntityStore::getInstance()->collectDeaths(_deadEntities);
+    
+    for (auto entity : _deadEntities) entity->retain();
+    for (auto entity : _deadEntities)
+    {
+        entity->die();
+    }
+    for (auto entity : _deadEntities) entity->release();
 }
 
 void GameScene::updateMapSystem(float dt)
 {
+    // 在时间预算内推进相邻房间的延迟构建
+    if (_mapGenerator) _mapGenerator->updateMaterialization();
+    
     // 玩家死亡或不存在时不更新地图系统
     if (_mapGenerator == nullptr || _player == nullptr || _player->isDead()) return;
     
@@ -578,6 +821,12 @@ void GameScene::updateMapSystem(float dt)
         // 在新房间生成敌人
         spawnEnemiesInRoom(_currentRoom);
         
+        // 到达终点房间时下一关已确定，开始后台预取
+        if (_currentRoom->getRoomType() == Constants::RoomType::END)
+        {
+            startNextLevelPrefetch();
+        }
+        
         // 更新小地图
         if (_miniMap)
         {
@@ -742,20 +991,134 @@ void GameScene::updateEnemies(float dt)
         return;
     }
     
+    auto startTime = std::chrono::steady_clock::now();
+    auto store = EntityStore::getInstance();
+    GameMetrics::AIStats stats;
+    _aiFrame++;
+    
+    // 游戏层坐标系下的可见区域（外扩一圈，边缘的敌人也按屏幕内处理）
+    Size visibleSize = Director::getInstance()->getVisibleSize();
+    Rect view(-_gameLayer->getPositionX() - Constants::AI::SCREEN_MARGIN,
+              -_gameLayer->getPositionY() - Constants::AI::SCREEN_MARGIN,
+              visibleSize.width + Constants::AI::SCREEN_MARGIN * 2.0f,
+              visibleSize.height + Constants::AI::SCREEN_MARGIN * 2.0f);
+    
+    auto inAttackRange = [](Enemy* enemy, float distSq) {
+        float nearRange = enemy->getAttackRange() + Constants::AI::ATTACK_MARGIN;
+        return distSq <= nearRange * nearRange;
+    };
+    
+    // 全速预算按到玩家的距离分配：攻击范围内的先占预算，其余名额给屏幕内最近的敌人，
+    // 用 nth_element 求出第 N 近的距离平方作为阈值（与 _enemies 的顺序无关）
+    int attackCount = 0;
+    _aiScreenDistSq.clear();
+    for (auto enemy : _enemies)
+    {
+        if (enemy == nullptr || enemy->isDead() || !isEnemyInActiveRoom(enemy))
+        {
+            continue;
+        }
+        float distSq = store->blackboard(enemy->getStoreSlot()).targetDistSq;
+        if (inAttackRange(enemy, distSq))
+        {
+            attackCount++;
+        }
+        else if (view.containsPoint(enemy->getPosition()))
+        {
+            _aiScreenDistSq.push_back(distSq);
+        }
+    }
+    int screenBudget = std::max(0, Constants::AI::FULL_RATE_BUDGET - attackCount);
+    float fullRateDistSq = std::numeric_limits<float>::max();
+    if (static_cast<int>(_aiScreenDistSq.size()) > screenBudget)
+    {
+        if (screenBudget == 0)
+        {
+            fullRateDistSq = -1.0f;
+        }
+        else
+        {
+            auto nth = _aiScreenDistSq.begin() + (screenBudget - 1);
+            std::nth_element(_aiScreenDistSq.begin(), nth, _aiScreenDistSq.end());
+            fullRateDistSq = *nth;
+        }
+    }
+    int screenFull = 0;
+    
     // 更新敌人AI
     for (auto enemy : _enemies)
     {
-        if (enemy != nullptr && !enemy->isDead())
+        if (enemy == nullptr || enemy->isDead())
+        {
+            continue;
+        }
+        
+        int slot = enemy->getStoreSlot();
+        auto& blackboard = store->blackboard(slot);
+        
+        // 冻结：不在当前房间（例如 Boss 召唤到房间外的小怪），恢复时不补时间
+        if (!isEnemyInActiveRoom(enemy))
+        {
+            blackboard.aiPendingDt = 0.0f;
+            stats.frozen++;
+            continue;
+        }
+        blackboard.aiPendingDt += dt;
+        
+        // 全速：攻击范围内始终全速；屏幕内距离不超过阈值的全速（距离相同时按顺序截断在预算内）
+        bool attacking = inAttackRange(enemy, blackboard.targetDistSq);
+        bool nearOnScreen = !attacking && blackboard.targetDistSq <= fullRateDistSq
+            && screenFull < screenBudget && view.containsPoint(enemy->getPosition());
+        if (nearOnScreen) screenFull++;
+        bool fullRate = attacking || nearOnScreen;
+        
+        // 低频：按槽位错开，每 REDUCED_INTERVAL 帧执行一次，使用累积的时间
+        if (!fullRate && (_aiFrame + slot) % Constants::AI::REDUCED_INTERVAL != 0)
         {
-            enemy->executeAI(_player, dt);
+            stats.skipped++;
+            continue;
         }
+        if (fullRate) stats.full++;
+        else stats.reduced++;
+        
+        float stepDt = blackboard.aiPendingDt;
+        blackboard.aiPendingDt = 0.0f;
+        enemy->executeAI(_player, stepDt);
+    }
+    
+    stats.ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    GameMetrics::recordAI(stats);
+}
+
+bool GameScene::isEnemyInActiveRoom(Enemy* enemy) const
+{
+    // 在走廊中（无当前房间）时不冻结
+    if (_currentRoom == nullptr)
+    {
+        return true;
     }
     
-    // 移除死亡的敌人
+    // 计入清房的敌人直接比较所属房间，其余按位置判断
+    Room* room = enemy->getClearRoom();
+    if (room != nullptr)
+    {
+        return room == _currentRoom;
+    }
+    return _currentRoom->getBounds().containsPoint(enemy->getPosition());
+}
+
+void GameScene::removeDeadEnemies()
+{
+    // 移除死亡的敌人（含 HP 未归零但已进入 DIE 的，例如消散的 Boat、被 Boss 清场的小怪），可复用的交回预留池
     for (auto it = _enemies.begin(); it != _enemies.end(); )
     {
-        if (*it == nullptr || (*it)->isDead())
+        if (*it == nullptr)
+        {
+            it = _enemies.erase(it);
+        }
+        else if ((*it)->isDead() || (*it)->getState() == EntityState::DIE)
         {
+            _enemyPool.recycle(*it);
             it = _enemies.erase(it);
         }
         else
@@ -763,15 +1126,25 @@ void GameScene::updateEnemies(float dt)
             ++it;
         }
     }
+}
+
+void GameScene::onRoomCleared(Room* room)
+{
+    // 场景退出（onExit）过程中释放的清房挂起不再触发任何逻辑
+    if (room == nullptr || !isRunning())
+    {
+        return;
+    }
     
-    // 检测boss房间胜利条件
-    if (_currentRoom && _currentRoom->getRoomType() == Constants::RoomType::BOSS)
+    if (_miniMap)
     {
-        if (_currentRoom->allEnemiesKilled())
-        {
-            GAME_LOG("Boss room cleared! Showing victory.");
-            showVictory();
-        }
+        _miniMap->updateRoomVisited(room->getGridX(), room->getGridY());
+    }
+    
+    if (room->getRoomType() == Constants::RoomType::BOSS)
+    {
+        GAME_LOG("Boss room cleared! Showing victory.");
+        showVictory();
     }
 }
 
@@ -923,7 +1296,7 @@ void GameScene::checkCollisions()
                 float dist = _player->getPosition().distance(enemy->getPosition());
                 if (dist < 80.0f)  // 攻击范围
                 {
-                    enemy->takeDamage(_player->getAttack());
+                    DamageQueue::getInstance()->push(enemy, _player->getAttack(), Color3B::WHITE, false);
                     GAME_LOG("Player hits enemy for %d damage!", _player->getAttack());
                 }
             }
@@ -1143,6 +1516,24 @@ void GameScene::setupKeyboardListener()
                 _currentRoom->openChest(_player);
             }
         }
+#ifdef COCOS2D_DEBUG
+        else if (keyCode == EventKeyboard::KeyCode::KEY_F8)
+        {
+            // 调试：开关 HUD 调试面板的运行时指标采集
+            GameMetrics::setEnabled(!GameMetrics::isEnabled());
+        }
+        else if (keyCode == EventKeyboard::KeyCode::KEY_F9)
+        {
+            // 调试：输出存活对象统计
+            LeakTracker::report();
+        }
+        else if (keyCode == EventKeyboard::KeyCode::KEY_F10)
+        {
+            // 调试：导出当前帧的运行时指标
+            GameMetrics::capture(this);
+            GameMetrics::dumpToFile();
+        }
+#endif
     };
     
     listener->onKeyReleased = [this](EventKeyboard::KeyCode keyCode, Event* event) {
@@ -1243,6 +1634,13 @@ void GameScene::showGameOver()
 
 void GameScene::showVictory()
 {
+    // 房间清空事件和 Boss 死亡兜底都可能调用，只处理一次
+    if (_isGameOver)
+    {
+        return;
+    }
+    _isGameOver = true;
+    
     GAME_LOG("Victory!");
     
     // 停止游戏更新
@@ -1271,6 +1669,70 @@ void GameScene::showVictory()
     }
 }
 
+void GameScene::getNextLevel(int& level, int& stage) const
+{
+    // 进入下一小关
+    level = _currentLevel;
+    stage = _currentStage + 1;
+    
+    // 1-3通关后进入Boss层（stage=0表示Boss层）
+    if (level == 1 && stage > 3)
+    {
+        stage = 0; // Boss层
+    }
+}
+
+void GameScene::startNextLevelPrefetch()
+{
+    if (_prefetchLoader) return;
+    
+    getNextLevel(_prefetchLevel, _prefetchStage);
+    GAME_LOG("Prefetching next level %d-%d", _prefetchLevel, _prefetchStage);
+    
+    _prefetchLoader = AssetPreloader::create();
+    CC_SAFE_RETAIN(_prefetchLoader);
+    
+    // 只解码资源：当前楼层仍在运行，不能切换 TextureBudget 的关卡清单；
+    // 资源常驻后由 updateNextLevelBuild 按帧预算构建下一关场景
+    _prefetchManifest = AssetPreloader::buildLevelManifest(_prefetchLevel, _prefetchStage);
+    _prefetchLoader->start(_prefetchManifest, nullptr, [this]() {
+        GAME_LOG("Next level %d-%d assets resident", _prefetchLevel, _prefetchStage);
+    });
+}
+
+void GameScene::cancelNextLevelPrefetch()
+{
+    if (_prefetchLoader)
+    {
+        _prefetchLoader->cancel();
+    }
+    CC_SAFE_RELEASE_NULL(_prefetchLoader);
+    CC_SAFE_RELEASE_NULL(_nextScene);
+}
+
+void GameScene::updateNextLevelBuild()
+{
+    if (!_prefetchLoader || !_prefetchLoader->isFinished())
+    {
+        return;
+    }
+    
+    if (!_nextScene)
+    {
+        // 新场景在 init 中读取静态变量；血蓝量与道具到传送时再写入
+        s_nextLevel = _prefetchLevel;
+        s_nextStage = _prefetchStage;
+        _nextScene = GameScene::createStaged();
+        CC_SAFE_RETAIN(_nextScene);
+        return;
+    }
+    
+    if (!_nextScene->isBuilt() && _nextScene->advanceBuild(NEXT_LEVEL_BUILD_BUDGET_MS))
+    {
+        GAME_LOG("Next level %d-%d scene built", _prefetchLevel, _prefetchStage);
+    }
+}
+
 void GameScene::goToNextLevel()
 {
     if (!_player)
@@ -1282,18 +1744,28 @@ void GameScene::goToNextLevel()
     int savedHP = _player->getHP();
     int savedMP = _player->getMP();
     
-    // 进入下一小关
-    int nextLevel = _currentLevel;
-    int nextStage = _currentStage + 1;
+    int nextLevel = 1;
+    int nextStage = 1;
+    getNextLevel(nextLevel, nextStage);
     
     GAME_LOG("Going to next level. Current: %d-%d, Next: %d-%d, Saving HP: %d, MP: %d", 
              _currentLevel, _currentStage, nextLevel, nextStage, savedHP, savedMP);
     
-    // 1-3通关后进入Boss层（stage=0表示Boss层）
-    if (nextLevel == 1 && nextStage > 3)
+    // 下一关已在终点房间中构建完成：只恢复血蓝量与道具并切换，跳过加载界面
+    if (_nextScene && _nextScene->isBuilt()
+        && _prefetchLevel == nextLevel && _prefetchStage == nextStage)
     {
-        nextStage = 0; // Boss层
+        // 此刻才真正离开当前楼层，改用下一关的纹理清单
+        TextureBudget::getInstance()->beginLevel(_prefetchManifest);
+        _nextScene->applyCarryOver(savedHP, savedMP, _collectedItems);
+        
+        // 先停下当前楼层，新场景的实体槽位不会被一并停用
+        suspendSimulation();
+        Director::getInstance()->replaceScene(TransitionFade::create(0.5f, _nextScene));
+        cancelNextLevelPrefetch();
+        return;
     }
+    cancelNextLevelPrefetch();
     
     // 使用静态变量传递信息给新场景
     s_nextLevel = nextLevel;
@@ -1305,13 +1777,43 @@ void GameScene::goToNextLevel()
     GAME_LOG("Set static vars for next scene: Level %d-%d, HP: %d, MP: %d, Items: %d", 
              nextLevel, nextStage, savedHP, savedMP, (int)_collectedItems.size());
     
-    // 创建新场景（init时会读取静态变量）
-    auto newScene = GameScene::createScene();
-    if (newScene)
+    // 经由加载场景切换（加载完成后创建新场景，init时会读取静态变量）
+    auto loadingScene = LoadingScene::createScene();
+    if (loadingScene)
     {
         // 切换场景
-        Director::getInstance()->replaceScene(TransitionFade::create(0.5f, newScene));
+        suspendSimulation();
+        Director::getInstance()->replaceScene(TransitionFade::create(0.5f, loadingScene));
+    }
+}
+
+void GameScene::suspendSimulation()
+{
+    if (_simulationSuspended)
+    {
+        return;
+    }
+    _simulationSuspended = true;
+    
+    this->unscheduleUpdate();
+    if (_player)
+    {
+        _player->removeInputEvents();
+    }
+    
+    TimerWheel::getInstance()->cancelAll(_timerOwner);
+    DamageQueue::getInstance()->clear();
+    
+    // 此时处于模拟中的实体都属于本场景（预建的下一关场景尚未进入，其实体不在模拟中）
+    auto store = EntityStore::getInstance();
+    _tickEntities.clear();
+    store->collectActive(_tickEntities);
+    for (auto entity : _tickEntities)
+    {
+        entity->cancelAllTimers();
+        store->setActive(entity->getStoreSlot(), false);
     }
+    _tickEntities.clear();
 }
 
 void GameScene::addEnemy(Enemy* enemy)
@@ -1321,8 +1823,7 @@ void GameScene::addEnemy(Enemy* enemy)
     // 添加到游戏层（显示）并注册到 _enemies（用于 AI 更新）
     if (_gameLayer)
     {
-        enemy->setGlobalZOrder(Constants::ZOrder::ENTITY);
-        _gameLayer->addChild(enemy);
+        _gameLayer->addChild(enemy, Constants::ZOrder::ENTITY);
     }
     else
     {
@@ -1353,19 +1854,8 @@ void GameScene::addEnemy(Enemy* enemy)
             Rect walk = room->getWalkableArea();
             if (walk.containsPoint(enemy->getPosition()))
             {
-                // 将敌人加入房间管理列表（避免重复），但只有在 countsForRoomClear() == true 时才计入
-                if (enemy->countsForRoomClear())
-                {
-                    bool inRoom = false;
-                    for (auto re : room->getEnemies())
-                    {
-                        if (re == enemy) { inRoom = true; break; }
-                    }
-                    if (!inRoom)
-                    {
-                        room->getEnemies().pushBack(enemy);
-                    }
-                }
+                // 将敌人登记到房间清房计数（内部会忽略重复登记和 countsForRoomClear() == false 的敌人）
+                room->registerEnemy(enemy);
 
                 // 将 Room::getWalkableArea 直接传给敌人，保证边界与房间墙匹配
                 enemy->setRoomBounds(walk);
@@ -15,6 +15,11 @@
 #include "UI/GameHUD.h"
 #include "UI/GameMenus.h"
 #include "Map/Barriers.h"
+#include "Managers/AssetPreloader.h"
+#include "Scenes/YSortLayer.h"
+#include "Entities/Base/EntityStore.h"
+#include "Entities/Enemy/EnemyPool.h"
+#include "Utils/TimerWheel.h"
 
 USING_NS_CC;
 
@@ -25,9 +30,15 @@ public:
     
     virtual bool init() override;
     virtual void update(float dt) override;
+    virtual void onEnter() override;
+    virtual void onEnterTransitionDidFinish() override;
+    virtual void onExit() override;
     
     CREATE_FUNC(GameScene);
     
+    GameScene();
+    virtual ~GameScene();
+    
     // 静态变量：用于场景切换时传递关卡信息和血蓝量
     static int s_nextLevel;
     static int s_nextStage;
@@ -41,6 +52,12 @@ public:
     // 由外部注册新生成的敌人（例如 Enemy::die 生成的 KongKaZi）
     void addEnemy(Enemy* enemy);
     
+    // 从本关的敌人预留池取出一个敌人（autorelease，预留不足时直接创建）
+    Enemy* acquireEnemy(EnemyKind kind);
+    
+    // 场景级延迟回调的拥有者（不属于某个实体的计时器，离开场景时取消）
+    TimerWheel::Owner* getTimerOwner() { return &_timerOwner; }
+    
     // 添加道具到UI显示
     void addItemToUI(const ItemDef* itemDef);
     
@@ -63,6 +80,9 @@ private:
     // 初始化地图系统
     void initMapSystem();
     
+    // 按本关房间的敌人预算设置并预热敌人预留池
+    void initEnemyPool();
+    
     // 初始化相机系统
     void initCamera();
     
@@ -72,19 +92,40 @@ private:
     // 更新地图和房间
     void updateMapSystem(float dt);
     
+    // 房间清空事件（由 Room 在最后一个计数敌人死亡时回调一次）
+    void onRoomCleared(Room* room);
+    
     // 创建HUD
     void createHUD();
     
     // 创建菜单系统
     void createMenus();
     
+    // 实体逻辑按固定顺序分阶段推进：状态 → AI → 移动 → 碰撞 → 伤害 → 清理
+    // 实体不再各自 scheduleUpdate，全部由下列阶段驱动
+    // 状态：推进实体组件系统（位置快照、黑板、计时器、状态效果），并把状态事件回放到节点
+    void updateEntitySystems(float dt);
+    
+    // 移动：按槽位顺序调用各实体的 update(dt)
+    void updateEntities(float dt);
+    
+    // 伤害：对 HP 已归零的实体统一执行死亡
+    void resolveDeaths();
+    
+    // 清理：把死亡的敌人移出 _enemies
+    void removeDeadEnemies();
+    
     // 更新玩家
     void updatePlayer(float dt);
     
-    // 更新敌人
+    // 更新敌人 AI（按距离与房间分级：全速 / 低频错帧 / 冻结，见 Constants::AI）
     void updateEnemies(float dt);
+    
     void updateSpikes(float dt);
     
+    // 敌人是否位于当前房间（不在当前房间的敌人 AI 冻结）
+    bool isEnemyInActiveRoom(Enemy* enemy) const;
+    
     // 更新交互系统
     void updateInteraction(float dt);
     
@@ -112,17 +153,53 @@ private:
     // 切换到下一关
     void goToNextLevel();
     
+    // 计算下一关的关卡编号
+    void getNextLevel(int& level, int& stage) const;
+    
+    // 进入终点房间后在后台预取下一关资源（只解码纹理/音频），资源常驻后逐帧构建下一关场景，
+    // 传送时只做切换
+    void startNextLevelPrefetch();
+    void cancelNextLevelPrefetch();
+    void updateNextLevelBuild();
+    
+    // 分阶段构建：只完成 Scene::init 与关卡信息读取，其余由 advanceBuild 逐帧推进
+    static GameScene* createStaged();
+    
+    // 推进构建阶段；budgetMs > 0 时超出预算即停止（敌人预留按预算分批创建），返回是否已构建完成
+    bool advanceBuild(float budgetMs);
+    bool isBuilt() const { return _buildStage == BuildStage::DONE; }
+    
+    // 预建场景在传送时才知道上一层的血蓝量与道具，进入前再恢复
+    void applyCarryOver(int hp, int mp, const std::vector<std::string>& items);
+    
+    // 恢复道具效果与血蓝量（读取 _collectedItems / _savedHP / _savedMP）
+    void restoreCarryOverState();
+    
     // 按键回调
     void setupKeyboardListener();
     
+    // 挂起本场景的实体模拟（切换场景前调用，可重复调用）
+    // 过渡动画期间新旧场景会同时存在，而实体存储、计时轮与伤害队列是全局共享的，
+    // 旧场景在这里停止逐帧更新、取消本场景实体的延迟回调、丢弃未结算的伤害并把实体移出模拟，
+    // 之后这些全局系统只由新场景推进
+    void suspendSimulation();
+    
 private:
     // 图层
-    Layer* _gameLayer;        // 游戏逻辑层
+    YSortLayer* _gameLayer;   // 游戏逻辑层（实体按 Y 排序）
     Layer* _uiLayer;          // UI层
     
     // 游戏对象
     Player* _player;
     Vector<Enemy*> _enemies;
+    EnemyPool _enemyPool;     // 本关敌人预留
+    std::vector<EntityStore::StatusEvent> _statusEvents;  // 每帧复用
+    std::vector<GameEntity*> _tickEntities;               // 每帧复用
+    std::vector<GameEntity*> _deadEntities;               // 每帧复用
+    unsigned int _aiFrame;                                // AI 低频错帧计数
+    std::vector<float> _aiScreenDistSq;                   // 屏幕内候选全速敌人的距离平方，每帧复用
+    
+    TimerWheel::Owner _timerOwner;                        // 场景级延迟回调
     
     // 地图系统
     MapGenerator* _mapGenerator;
@@ -136,6 +213,7 @@ private:
     
     // 状态
     bool _isPaused;
+    bool _simulationSuspended;
     bool _isGameOver;
     bool _keyE;  // E键交互状态
     
@@ -145,6 +223,30 @@ private:
     int _savedHP;          // 保存的血量
     int _savedMP;          // 保存的蓝量
     std::vector<std::string> _collectedItems;  // 已收集的道具ID列表
+    
+    // 构建阶段（同步构建时在 init 中一次走完）
+    enum class BuildStage {
+        MAP,          // 图层、地图布局、敌人预留目标
+        ENEMY_POOL,   // 按预算预热敌人预留
+        PLAYER,       // 玩家、相机、HUD
+        UI,           // 菜单、按键、update
+        DONE
+    };
+    BuildStage _buildStage;
+    bool _stagedBuild;
+    
+    // 预建下一关时每帧用于构建的时间预算（毫秒）
+    static constexpr float NEXT_LEVEL_BUILD_BUDGET_MS = 2.0f;
+    
+    // 下一关预取
+    AssetPreloader* _prefetchLoader;   // 后台解码下一关资源
+    GameScene* _nextScene;             // 资源常驻后逐帧构建的下一关场景
+    AssetManifest _prefetchManifest;   // 预取的清单（传送时再登记到 TextureBudget）
+    int _prefetchLevel;
+    int _prefetchStage;
+    
+    // 存活对象追踪的场景代号
+    int _leakGeneration;
 };
 
 #endif // __GAME_SCENE_H__
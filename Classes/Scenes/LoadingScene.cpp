@@ -0,0 +1,120 @@
+﻿#include "LoadingScene.h"
+#include "GameScene.h"
+#include "Managers/TextureBudget.h"
+
+USING_NS_CC;
+
+Scene* LoadingScene::createScene()
+{
+    return LoadingScene::create();
+}
+
+LoadingScene::LoadingScene()
+    : _preloader(nullptr)
+    , _progressFill(nullptr)
+    , _progressLabel(nullptr)
+    , _barWidth(0.0f)
+    , _started(false)
+{
+}
+
+LoadingScene::~LoadingScene()
+{
+    CC_SAFE_RELEASE_NULL(_preloader);
+}
+
+bool LoadingScene::init()
+{
+    if (!Scene::init())
+    {
+        return false;
+    }
+    
+    _preloader = AssetPreloader::create();
+    CC_SAFE_RETAIN(_preloader);
+    
+    createUI();
+    
+    GAME_LOG("LoadingScene initialized for level %d-%d", GameScene::s_nextLevel, GameScene::s_nextStage);
+    return true;
+}
+
+void LoadingScene::createUI()
+{
+    auto visibleSize = Director::getInstance()->getVisibleSize();
+    Vec2 origin = Director::getInstance()->getVisibleOrigin();
+    
+    auto bgColor = LayerColor::create(Color4B(0, 0, 0, 255));
+    this->addChild(bgColor);
+    
+    _barWidth = visibleSize.width * 0.5f;
+    float barHeight = 16.0f;
+    float barX = origin.x + (visibleSize.width - _barWidth) * 0.5f;
+    float barY = origin.y + visibleSize.height * 0.3f;
+    
+    auto barBg = LayerColor::create(Color4B(60, 60, 60, 255), _barWidth, barHeight);
+    barBg->setPosition(Vec2(barX, barY));
+    this->addChild(barBg);
+    
+    _progressFill = LayerColor::create(Color4B(230, 200, 80, 255), 0.0f, barHeight);
+    _progressFill->setPosition(Vec2(barX, barY));
+    this->addChild(_progressFill);
+    
+    _progressLabel = Label::createWithTTF(u8"加载中... 0%", "fonts/msyh.ttf", 28);
+    _progressLabel->setPosition(Vec2(origin.x + visibleSize.width * 0.5f, barY + 50.0f));
+    this->addChild(_progressLabel);
+}
+
+void LoadingScene::onEnterTransitionDidFinish()
+{
+    Scene::onEnterTransitionDidFinish();
+    
+    // 淡入结束后再开始提交，避免与上一场景的释放争抢主线程
+    if (_started || !_preloader) return;
+    _started = true;
+    
+    auto manifest = AssetPreloader::buildLevelManifest(GameScene::s_nextLevel, GameScene::s_nextStage);
+    
+    // 加载场景之后必然进入该关卡，以本次清单作为当前关卡的纹理集合
+    TextureBudget::getInstance()->beginLevel(manifest);
+    _preloader->start(manifest,
+        [this](int loaded, int total) { updateProgress(loaded, total); },
+        [this]() { onLoadFinished(); });
+}
+
+void LoadingScene::onExit()
+{
+    if (_preloader)
+    {
+        _preloader->cancel();
+    }
+    Scene::onExit();
+}
+
+void LoadingScene::updateProgress(int loaded, int total)
+{
+    float percent = total > 0 ? (float)loaded / (float)total : 1.0f;
+    
+    if (_progressFill)
+    {
+        _progressFill->changeWidth(_barWidth * percent);
+    }
+    if (_progressLabel)
+    {
+        _progressLabel->setString(StringUtils::format(u8"加载中... %d%%", (int)(percent * 100.0f)));
+    }
+}
+
+void LoadingScene::onLoadFinished()
+{
+    updateProgress(1, 1);
+    
+    // 延后一帧切换：完成回调可能在 addImageAsync 内同步触发
+    this->scheduleOnce([](float) {
+        auto gameScene = GameScene::createScene();
+        if (gameScene)
+        {
+            Director::getInstance()->replaceScene(TransitionFade::create(0.5f, gameScene));
+        }
+    }, 0.0f, "loading_finished");
+}
@@ -0,0 +1,38 @@
+﻿#ifndef __LOADING_SCENE_H__
+#define __LOADING_SCENE_H__
+
+#include "cocos2d.h"
+#include "Core/Constants.h"
+#include "Core/GameMacros.h"
+#include "Managers/AssetPreloader.h"
+
+USING_NS_CC;
+
+// 加载场景 - 异步预加载下一关资源并显示进度，全部常驻后才创建 GameScene
+// 关卡信息沿用 GameScene::s_nextLevel / s_nextStage（由调用方在切换前设置）
+class LoadingScene : public Scene {
+public:
+    static Scene* createScene();
+    virtual bool init() override;
+    CREATE_FUNC(LoadingScene);
+    
+    virtual void onEnterTransitionDidFinish() override;
+    virtual void onExit() override;
+    
+private:
+    LoadingScene();
+    virtual ~LoadingScene();
+    
+    void createUI();
+    void updateProgress(int loaded, int total);
+    void onLoadFinished();
+    
+private:
+    AssetPreloader* _preloader;
+    LayerColor* _progressFill;
+    Label* _progressLabel;
+    float _barWidth;
+    bool _started;
+};
+
+#endif // __LOADING_SCENE_H__
@@ -1,9 +1,12 @@
 ﻿#include "MainMenuScene.h"
 #include "GameScene.h"
+#include "LoadingScene.h"
 #include "UI/CharacterSelectLayer.h"
 #include "ui/CocosGUI.h"
 #include "audio/include/AudioEngine.h"
 #include "Managers/SoundManager.h"
+#include "Utils/TimerWheel.h"
+#include "Entities/Base/DamageQueue.h"
 
 USING_NS_CC;
 using namespace ui;
@@ -131,9 +134,9 @@ void MainMenuScene::onStartGame(Ref* sender)
 {
     GAME_LOG("Start game clicked");
     
-    // 切换到游戏场景
-    auto gameScene = GameScene::createScene();
-    Director::getInstance()->replaceScene(TransitionFade::create(1.0f, gameScene));
+    // 先进入加载场景，资源常驻后再创建游戏场景
+    auto loadingScene = LoadingScene::createScene();
+    Director::getInstance()->replaceScene(TransitionFade::create(1.0f, loadingScene));
 }
 
 void MainMenuScene::onStartBossLevel(Ref* sender)
@@ -144,9 +147,9 @@ void MainMenuScene::onStartBossLevel(Ref* sender)
     GameScene::s_nextLevel = 1;
     GameScene::s_nextStage = 0;
     
-    // 切换到游戏场景
-    auto gameScene = GameScene::createScene();
-    Director::getInstance()->replaceScene(TransitionFade::create(1.0f, gameScene));
+    // 先进入加载场景，资源常驻后再创建游戏场景
+    auto loadingScene = LoadingScene::createScene();
+    Director::getInstance()->replaceScene(TransitionFade::create(1.0f, loadingScene));
 }
 
 void MainMenuScene::onSelectCharacter(Ref* sender)
@@ -177,6 +180,10 @@ void MainMenuScene::onExit(Ref* sender)
     // 先销毁SoundManager（会清除所有音频回调）
     SoundManager::destroyInstance();
     
+    // 丢弃未执行的延迟回调与未结算的伤害
+    TimerWheel::destroyInstance();
+    DamageQueue::destroyInstance();
+    
     // 停止所有剩余音频
     AudioEngine::stopAll();
     
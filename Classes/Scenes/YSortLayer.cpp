@@ -0,0 +1,59 @@
+﻿#include "YSortLayer.h"
+
+YSortLayer::YSortLayer()
+: _sortedZOrder(Constants::ZOrder::ENTITY)
+, _lastMoveCount(0)
+{
+}
+
+bool YSortLayer::init()
+{
+    if (!Layer::init())
+    {
+        return false;
+    }
+    return true;
+}
+
+bool YSortLayer::drawsBefore(Node* a, Node* b) const
+{
+    int za = a->getLocalZOrder();
+    int zb = b->getLocalZOrder();
+    if (za != zb) return za < zb;
+    // 同一局部 Z 序内：Y 大的（画面靠上、离镜头远）先画；其余层保持原有先后顺序
+    if (za == _sortedZOrder) return a->getPositionY() > b->getPositionY();
+    return false;
+}
+
+void YSortLayer::sortAllChildren()
+{
+    // 稳定插入排序：新加入的节点从末尾插入到位，实体移动只与相邻节点交换
+    // 相同键的节点不交换，因此非实体层仍按加入顺序绘制
+    int moved = 0;
+    if (_children.size() > 1)
+    {
+        auto first = _children.begin();
+        for (auto it = first + 1; it != _children.end(); ++it)
+        {
+            Node* node = *it;
+            auto hole = it;
+            while (hole != first && drawsBefore(node, *(hole - 1)))
+            {
+                *hole = *(hole - 1);
+                --hole;
+            }
+            if (hole != it)
+            {
+                *hole = node;
+                ++moved;
+            }
+        }
+    }
+    
+    _lastMoveCount = moved;
+    _reorderChildDirty = false;
+    if (moved > 0)
+    {
+        _eventDispatcher->setDirtyForNode(this);
+    }
+}
@@ -0,0 +1,37 @@
+﻿#ifndef __Y_SORT_LAYER_H__
+#define __Y_SORT_LAYER_H__
+
+#include "cocos2d.h"
+#include "Core/Constants.h"
+
+USING_NS_CC;
+
+// 游戏层 - 实体所在的局部 Z 序（ENTITY）内按 Y 坐标排序：Y 越小越靠前绘制在上面
+// 子节点顺序逐帧保持近乎有序，用插入排序增量维护（O(n)），只有顺序真正变化时才标记脏
+// 实体无需逐帧 setLocalZOrder，因此不会触发父节点的整体重排
+class YSortLayer : public Layer {
+public:
+    CREATE_FUNC(YSortLayer);
+    
+    virtual bool init() override;
+    virtual void sortAllChildren() override;
+    
+    // 参与 Y 排序的局部 Z 序（默认 ENTITY）
+    void setSortedZOrder(int zOrder) { _sortedZOrder = zOrder; }
+    int getSortedZOrder() const { return _sortedZOrder; }
+    
+    // 上一次排序移动的节点数（调试用）
+    int getLastMoveCount() const { return _lastMoveCount; }
+    
+protected:
+    YSortLayer();
+    
+    // a 是否应绘制在 b 之前
+    bool drawsBefore(Node* a, Node* b) const;
+    
+private:
+    int _sortedZOrder;
+    int _lastMoveCount;
+};
+
+#endif // __Y_SORT_LAYER_H__
@@ -1,11 +1,114 @@
 ﻿#include "FloatingText.h"
 #include "Core/Constants.h"
+#include "Utils/HitchDetector.h"
 
 USING_NS_CC;
 
 namespace {
+    struct FloatingEntry {
+        Label* label = nullptr;
+        Vec2 origin;
+        float elapsed = 0.0f;
+        float duration = 0.0f;
+        int fontSize = 0;
+        bool active = false;
+    };
+
+    static std::vector<FloatingEntry> s_entries;   // 对象池（Label 由池 retain）
     static size_t s_activeCount = 0;
-    static const size_t MAX_ACTIVE = 15;
+    static bool s_scheduled = false;
+    static int s_schedulerTarget = 0;              // 调度器需要一个稳定的 target 指针
+    static const size_t MAX_ACTIVE = 128;          // 超出时复用最旧的跳字，而不是丢弃
+    static const float RISE_DISTANCE = 30.0f;
+    static const float FADE_RATIO = 0.6f;          // 最后 60% 时间淡出
+
+    Label* createLabel(const std::string& text, int fontSize)
+    {
+        HitchScope scope("createLabelTTF");
+        Label* label = Label::createWithTTF(text, "fonts/msyh.ttf", fontSize);
+        if (!label)
+        {
+            label = Label::createWithSystemFont(text, "Arial", fontSize);
+        }
+        if (!label) return nullptr;
+
+        label->setAnchorPoint(Vec2(0.5f, 0.5f));
+        label->retain();
+        return label;
+    }
+
+    void setFontSize(Label* label, int fontSize)
+    {
+        TTFConfig config = label->getTTFConfig();
+        if (!config.fontFilePath.empty())
+        {
+            config.fontSize = fontSize;
+            label->setTTFConfig(config);
+        }
+        else
+        {
+            label->setSystemFontSize(fontSize);
+        }
+    }
+
+    void deactivate(FloatingEntry& entry)
+    {
+        if (entry.label->getParent())
+        {
+            entry.label->removeFromParent();
+        }
+        entry.active = false;
+        if (s_activeCount > 0)
+        {
+            --s_activeCount;
+        }
+    }
+
+    // 取一个可用槽位：空闲槽 > 新建 > 复用进度最靠后的活动跳字
+    FloatingEntry* acquireEntry(int fontSize)
+    {
+        for (auto& entry : s_entries)
+        {
+            if (!entry.active) return &entry;
+        }
+
+        if (s_entries.size() < MAX_ACTIVE)
+        {
+            Label* label = createLabel("0", fontSize);
+            if (!label) return nullptr;
+            FloatingEntry entry;
+            entry.label = label;
+            entry.fontSize = fontSize;
+            s_entries.push_back(entry);
+            return &s_entries.back();
+        }
+
+        FloatingEntry* oldest = nullptr;
+        float oldestProgress = -1.0f;
+        for (auto& entry : s_entries)
+        {
+            float progress = entry.duration > 0.0f ? entry.elapsed / entry.duration : 1.0f;
+            if (progress > oldestProgress)
+            {
+                oldestProgress = progress;
+                oldest = &entry;
+            }
+        }
+        if (oldest)
+        {
+            deactivate(*oldest);
+        }
+        return oldest;
+    }
+
+    void ensureScheduled()
+    {
+        if (s_scheduled) return;
+        s_scheduled = true;
+        Director::getInstance()->getScheduler()->schedule([](float dt) {
+            FloatingText::update(dt);
+        }, &s_schedulerTarget, 0.0f, false, "FloatingText::update");
+    }
 }
 
 // 跳字功能实现：包括伤害数字、治疗数字、战士护盾的抵挡标志文字等
@@ -13,49 +116,82 @@ void FloatingText::show(Node* parent, const Vec2& pos, const std::string& text,
 {
     if (parent == nullptr) return;
 
-    if (s_activeCount >= MAX_ACTIVE)
-    {
-        return;
-    }
+    FloatingEntry* entry = acquireEntry(fontSize);
+    if (!entry) return;
 
-    Label* label = Label::createWithTTF(text, "fonts/msyh.ttf", fontSize);
-    if (!label)
+    Label* label = entry->label;
+    if (entry->fontSize != fontSize)
     {
-        label = Label::createWithSystemFont(text, "Arial", fontSize);
+        setFontSize(label, fontSize);
+        entry->fontSize = fontSize;
     }
-    if (!label) return;
-
+    label->setString(text);
     label->setTextColor(Color4B(color));
-    label->setAnchorPoint(Vec2(0.5f, 0.5f));
-
+    label->setOpacity(255);
     label->setPosition(pos);
-    label->setGlobalZOrder(Constants::ZOrder::EFFECT + 1);
 
-    parent->addChild(label);
+    if (label->getParent() != parent)
+    {
+        if (label->getParent())
+        {
+            label->removeFromParent();
+        }
+        parent->addChild(label, Constants::ZOrder::EFFECT + 1);
+    }
 
+    entry->origin = pos;
+    entry->elapsed = 0.0f;
+    entry->duration = duration > 0.0f ? duration : 0.01f;
+    entry->active = true;
     ++s_activeCount;
 
-    Vec2 moveBy = Vec2(0, 30.0f);
-    float fadeTime = duration * 0.6f;
-    float totalTime = duration;
+    ensureScheduled();
+}
+
+void FloatingText::prewarm(int count, int fontSize)
+{
+    while ((int)s_entries.size() < count && s_entries.size() < MAX_ACTIVE)
+    {
+        Label* label = createLabel("0", fontSize);
+        if (!label) return;
+        FloatingEntry entry;
+        entry.label = label;
+        entry.fontSize = fontSize;
+        s_entries.push_back(entry);
+    }
+}
 
-    auto move = MoveBy::create(totalTime, moveBy);
-    auto fade = FadeOut::create(fadeTime);
-    auto delay = DelayTime::create(totalTime - fadeTime);
-    auto seq = Sequence::create(delay, fade, nullptr);
-    auto spawn = Spawn::createWithTwoActions(move, seq);
+void FloatingText::update(float dt)
+{
+    if (s_activeCount == 0) return;
 
-    auto cleanup = CallFunc::create([label]() {
-        if (label->getParent())
+    for (auto& entry : s_entries)
+    {
+        if (!entry.active) continue;
+
+        // 父节点已被销毁（例如切换场景），直接回收
+        if (entry.label->getParent() == nullptr)
         {
-            label->removeFromParent();
+            deactivate(entry);
+            continue;
         }
-        if (s_activeCount > 0)
+
+        entry.elapsed += dt;
+        if (entry.elapsed >= entry.duration)
         {
-            --s_activeCount;
+            deactivate(entry);
+            continue;
         }
-    });
 
-    auto full = Sequence::create(spawn, cleanup, nullptr);
-    label->runAction(full);
-}
\ No newline at end of file
+        float t = entry.elapsed / entry.duration;
+        entry.label->setPosition(entry.origin + Vec2(0.0f, RISE_DISTANCE * t));
+
+        float fadeTime = entry.duration * FADE_RATIO;
+        float fadeStart = entry.duration - fadeTime;
+        if (entry.elapsed > fadeStart)
+        {
+            float alpha = 1.0f - (entry.elapsed - fadeStart) / fadeTime;
+            entry.label->setOpacity((GLubyte)(255.0f * alpha));
+        }
+    }
+}
@@ -2,8 +2,15 @@
 #include "cocos2d.h"
 using namespace cocos2d;
 
+// 跳字系统：Label 对象池 + 统一的帧更新，不再为每个跳字创建动作链
 class FloatingText {
 public:
     // 显示跳字
     static void show(Node* parent, const Vec2& pos, const std::string& text, const Color3B& color, int fontSize = 20, float duration = 1.2f);
-};
\ No newline at end of file
+
+    // 预先创建一批 Label（同字号共享字形图集，避免战斗中首次创建的卡顿）
+    static void prewarm(int count, int fontSize = 20);
+
+    // 推进所有活动跳字（由调度器每帧调用一次）
+    static void update(float dt);
+};
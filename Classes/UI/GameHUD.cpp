@@ -2,6 +2,7 @@
 #include "Entities/Player/Player.h"
 #include "Map/Room.h"
 #include "Entities/Objects/Item.h"
+#include "Utils/GameMetrics.h"
 
 GameHUD* GameHUD::create()
 {
@@ -38,10 +39,21 @@ bool GameHUD::init()
     _debugLabel = nullptr;
     _interactionLabel = nullptr;
     _itemSlots.clear();
+    _shownHP = -1;
+    _shownMaxHP = -1;
+    _shownMP = -1;
+    _shownMaxMP = -1;
+    _shownAttack = -1;
+    _skillCooling = true;   // 首次更新时强制同步一次冷却状态
+    _healCooling = true;
+    _slowRefreshTimer = SLOW_REFRESH_INTERVAL;
     
     createStatusBars();
     createSkillIcons();
+#ifdef COCOS2D_DEBUG
+    // 调试信息只在调试构建显示
     createDebugInfo();
+#endif
     createControlHints();
     
     return true;
@@ -220,7 +232,9 @@ void GameHUD::createDebugInfo()
     Vec2 origin = Director::getInstance()->getVisibleOrigin();
     
     _debugLabel = Label::createWithSystemFont("", "Arial", 18);
-    _debugLabel->setPosition(Vec2(origin.x + visibleSize.width - 150, origin.y + visibleSize.height - 30));
+    // 顶端对齐：指标行数随敌人种类变化，向下展开
+    _debugLabel->setAnchorPoint(Vec2(0.5f, 1.0f));
+    _debugLabel->setPosition(Vec2(origin.x + visibleSize.width - 150, origin.y + visibleSize.height - 10));
     _debugLabel->setTextColor(Color4B::YELLOW);
     _debugLabel->setGlobalZOrder(Constants::ZOrder::UI_GLOBAL);
     this->addChild(_debugLabel);
@@ -247,74 +261,69 @@ void GameHUD::update(Player* player, Room* currentRoom, int roomCount)
         return;
     }
     
+    // 冷却进度和Debug信息每秒只刷新数次，数值类 Label 仅在数值变化时刷新
+    _slowRefreshTimer += Director::getInstance()->getDeltaTime();
+    bool slowRefresh = _slowRefreshTimer >= SLOW_REFRESH_INTERVAL;
+    if (slowRefresh)
+    {
+        _slowRefreshTimer = 0.0f;
+    }
+    
     // 玩家死亡时显示HP为0
     int currentHP = player->isDead() ? 0 : player->getHP();
     int maxHP = player->getMaxHP();
-    float hpPercent = (maxHP > 0) ? (currentHP * 100.0f / maxHP) : 0.0f;
-    _hpBar->setPercent(hpPercent);
-    
-    char hpText[32];
-    sprintf(hpText, "%d/%d", currentHP, maxHP);
-    _hpLabel->setString(hpText);
+    if (currentHP != _shownHP || maxHP != _shownMaxHP)
+    {
+        _shownHP = currentHP;
+        _shownMaxHP = maxHP;
+        
+        float hpPercent = (maxHP > 0) ? (currentHP * 100.0f / maxHP) : 0.0f;
+        _hpBar->setPercent(hpPercent);
+        
+        char hpText[32];
+        sprintf(hpText, "%d/%d", currentHP, maxHP);
+        _hpLabel->setString(hpText);
+    }
     
     // 更新MP蓝条
     int currentMP = player->getMP();
     int maxMP = player->getMaxMP();
-    float mpPercent = (maxMP > 0) ? (currentMP * 100.0f / maxMP) : 0.0f;
-    _mpBar->setPercent(mpPercent);
-    
-    char mpText[32];
-    sprintf(mpText, "%d/%d", currentMP, maxMP);
-    _mpLabel->setString(mpText);
+    if (currentMP != _shownMP || maxMP != _shownMaxMP)
+    {
+        _shownMP = currentMP;
+        _shownMaxMP = maxMP;
+        
+        float mpPercent = (maxMP > 0) ? (currentMP * 100.0f / maxMP) : 0.0f;
+        _mpBar->setPercent(mpPercent);
+        
+        char mpText[32];
+        sprintf(mpText, "%d/%d", currentMP, maxMP);
+        _mpLabel->setString(mpText);
+    }
     
     // 更新攻击力
-    if (_attackLabel) {
+    if (_attackLabel && player->getAttack() != _shownAttack) {
+        _shownAttack = player->getAttack();
+        
         char atkText[32];
-        sprintf(atkText, "ATK: %d", player->getAttack());
+        sprintf(atkText, "ATK: %d", _shownAttack);
         _attackLabel->setString(atkText);
     }
     
     // 更新技能冷却
-    float remain = player->getSkillCooldownRemaining();
-    float totalCD = player->getSkillCooldown();
-    
-    if (remain <= 0.0f)
-    {
-        _skillIcon->setOpacity(255);
-        _skillCDMask->setVisible(false);
-        _skillCDProgress->setVisible(false);
-    }
-    else
-    {
-        _skillIcon->setOpacity(200);
-        _skillCDMask->setVisible(true);
-        _skillCDProgress->setVisible(true);
-        
-        float cdPercent = (totalCD > 0) ? ((totalCD - remain) / totalCD * 100.0f) : 0.0f;
-        _skillCDProgress->setPercentage(100.0f - cdPercent);
-    }
+    updateCooldown(player->getSkillCooldownRemaining(), player->getSkillCooldown(), slowRefresh,
+                   _skillIcon, _skillCDMask, _skillCDProgress, _skillCooling);
     
     // 更新治疗技能冷却
-    float healRemain = player->getHealCooldownRemaining();
-    float healTotalCD = player->getHealCooldown();
+    updateCooldown(player->getHealCooldownRemaining(), player->getHealCooldown(), slowRefresh,
+                   _healIcon, _healCDMask, _healCDProgress, _healCooling);
     
-    if (healRemain <= 0.0f)
-    {
-        _healIcon->setOpacity(255);
-        _healCDMask->setVisible(false);
-        _healCDProgress->setVisible(false);
-    }
-    else
+    // 更新Debug信息（包含实时坐标，按限频刷新）
+    if (!slowRefresh || !_debugLabel)
     {
-        _healIcon->setOpacity(200);
-        _healCDMask->setVisible(true);
-        _healCDProgress->setVisible(true);
-        
-        float healCdPercent = (healTotalCD > 0) ? ((healTotalCD - healRemain) / healTotalCD * 100.0f) : 0.0f;
-        _healCDProgress->setPercentage(100.0f - healCdPercent);
+        return;
     }
     
-    // 更新Debug信息
     char debugText[128];
     const char* roomTypeStr = "Unknown";
     if (currentRoom) {
@@ -327,12 +336,57 @@ void GameHUD::update(Player* player, Room* currentRoom, int roomCount)
             default: break;
         }
     }
-    sprintf(debugText, "Room: %s\nRooms: %d\nPos: (%.0f, %.0f)", 
+    // 上一帧的实际绘制批次（调度器更新早于渲染，读到的是上一帧统计）
+    auto renderer = Director::getInstance()->getRenderer();
+    sprintf(debugText, "Room: %s\nRooms: %d\nPos: (%.0f, %.0f)\nDraws: %d", 
             roomTypeStr,
             roomCount,
             player->getPositionX(),
-            player->getPositionY());
-    _debugLabel->setString(debugText);
+            player->getPositionY(),
+            static_cast<int>(renderer->getDrawnBatches()));
+    std::string text(debugText);
+    if (GameMetrics::isEnabled())
+    {
+        text += "\n" + GameMetrics::toDebugString();
+    }
+    if (_debugLabel->getString() != text)
+    {
+        _debugLabel->setString(text);
+    }
+}
+
+void GameHUD::updateCooldown(float remain, float total, bool refreshProgress,
+                             Sprite* icon, Sprite* mask, ProgressTimer* progress, bool& cooling)
+{
+    bool nowCooling = remain > 0.0f;
+    
+    if (!nowCooling)
+    {
+        if (cooling)
+        {
+            icon->setOpacity(255);
+            mask->setVisible(false);
+            progress->setVisible(false);
+            cooling = false;
+        }
+        return;
+    }
+    
+    // 刚进入冷却时立即显示，之后按限频推进进度
+    if (!cooling)
+    {
+        icon->setOpacity(200);
+        mask->setVisible(true);
+        progress->setVisible(true);
+        cooling = true;
+        refreshProgress = true;
+    }
+    
+    if (refreshProgress)
+    {
+        float cdPercent = (total > 0) ? ((total - remain) / total * 100.0f) : 0.0f;
+        progress->setPercentage(100.0f - cdPercent);
+    }
 }
 
 void GameHUD::addItemIcon(const ItemDef* itemDef)
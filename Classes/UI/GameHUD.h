@@ -42,7 +42,15 @@ private:
     void createDebugInfo();
     void createControlHints();
     
+    // 更新单个技能的冷却显示（就绪状态切换立即生效，进度按限频刷新）
+    void updateCooldown(float remain, float total, bool refreshProgress,
+                        Sprite* icon, Sprite* mask, ProgressTimer* progress, bool& cooling);
+    
 private:
+    // 冷却进度与Debug信息的刷新间隔（秒）
+    static constexpr float SLOW_REFRESH_INTERVAL = 0.1f;
+    
+
     // 血条相关
     cocos2d::ui::LoadingBar* _hpBar;
     Sprite* _hpIcon;
@@ -74,6 +82,16 @@ private:
     
     // 道具栏
     std::vector<Sprite*> _itemSlots;
+    
+    // 上次显示的数值（变化时才重新格式化并排版对应的 Label）
+    int _shownHP;
+    int _shownMaxHP;
+    int _shownMP;
+    int _shownMaxMP;
+    int _shownAttack;
+    bool _skillCooling;
+    bool _healCooling;
+    float _slowRefreshTimer;
 };
 
 #endif // __GAME_HUD_H__
@@ -2,6 +2,8 @@
 #include "Scenes/MainMenuScene.h"
 #include "audio/include/AudioEngine.h"
 #include "Managers/SoundManager.h"
+#include "Utils/TimerWheel.h"
+#include "Entities/Base/DamageQueue.h"
 
 USING_NS_CC;
 
@@ -132,6 +134,9 @@ void GameMenus::showPauseMenu()
     _exitBtn->addClickEventListener([](Ref* sender) {
         // 先销毁SoundManager（会清除所有音频回调）
         SoundManager::destroyInstance();
+        // 丢弃未执行的延迟回调与未结算的伤害
+        TimerWheel::destroyInstance();
+        DamageQueue::destroyInstance();
         // 停止所有剩余音频
         AudioEngine::stopAll();
         // 清除所有音频缓存和回调
@@ -4,121 +4,30 @@
 
 USING_NS_CC;
 
-// MiniRoom小地图中的小房间
-
-MiniRoom* MiniRoom::create() {
-    MiniRoom* room = new (std::nothrow) MiniRoom();
-    if (room && room->init()) {
-        room->autorelease();
-        return room;
-    }
-    CC_SAFE_DELETE(room);
-    return nullptr;
-}
-
-bool MiniRoom::init() {
-    if (!Node::init()) {
-        return false;
-    }
-    
-    _isCurrent = false;
-    
-    _background = DrawNode::create();
-    _background->setGlobalZOrder(Constants::ZOrder::UI_GLOBAL);
-    this->addChild(_background);
-    
-    for (int i = 0; i < 4; i++) {
-        _doors[i] = DrawNode::create();
-        _doors[i]->setVisible(false);
-        _doors[i]->setGlobalZOrder(Constants::ZOrder::UI_GLOBAL);
-        this->addChild(_doors[i]);
-    }
-    
-    return true;
-}
-
-void MiniRoom::setRoomColor(Constants::RoomType type) {
-    Color4F color;
-    
-    switch (type) {
-        case Constants::RoomType::BEGIN:
-            color = Color4F(0.0f, 0.8f, 0.0f, 0.8f);  // 绿色：起始房间
-            break;
-        case Constants::RoomType::END:
-            color = Color4F(0.4f, 0.7f, 1.0f, 0.8f);  // 浅蓝色：传送门房间
-            break;
-        case Constants::RoomType::BOSS:
-            color = Color4F(0.9f, 0.0f, 0.0f, 0.8f);  // 红色：BOSS房间
-            break;
-        case Constants::RoomType::REWARD:
-            color = Color4F(0.9f, 0.6f, 0.1f, 0.8f);  // 橙色：奖励房间
-            break;
-        case Constants::RoomType::NORMAL:
-        default:
-            color = Color4F(0.3f, 0.3f, 0.3f, 0.8f);  // 灰色：普通战斗房间
-            break;
-    }
-    
-    float size = 16.0f;
-    _background->clear();
-    _background->drawSolidRect(Vec2(-size/2, -size/2), Vec2(size/2, size/2), color);
-    
-    Color4F borderColor = _isCurrent ? Color4F::WHITE : Color4F(0.5f, 0.5f, 0.5f, 0.8f);
-    _background->drawRect(Vec2(-size/2, -size/2), Vec2(size/2, size/2), borderColor);
-}
-
-void MiniRoom::setCurrent(bool isCurrent) {
-    _isCurrent = isCurrent;
-}
-
-void MiniRoom::setVisited(bool visited) {
-    // 已访问的房间透明度降低，显示为变暗效果
-    if (visited) {
-        this->setOpacity(180);  // 透明度降低到70%
-        _background->setOpacity(180);
-        for (int i = 0; i < 4; i++) {
-            _doors[i]->setOpacity(180);
-        }
-    } else {
-        this->setOpacity(255);  // 未访问房间完全不透明
-        _background->setOpacity(255);
-        for (int i = 0; i < 4; i++) {
-            _doors[i]->setOpacity(255);
+namespace {
+    // 房间类型颜色
+    Color4F roomColor(Constants::RoomType type) {
+        switch (type) {
+            case Constants::RoomType::BEGIN:
+                return Color4F(0.0f, 0.8f, 0.0f, 0.8f);  // 绿色：起始房间
+            case Constants::RoomType::END:
+                return Color4F(0.4f, 0.7f, 1.0f, 0.8f);  // 浅蓝色：传送门房间
+            case Constants::RoomType::BOSS:
+                return Color4F(0.9f, 0.0f, 0.0f, 0.8f);  // 红色：BOSS房间
+            case Constants::RoomType::REWARD:
+                return Color4F(0.9f, 0.6f, 0.1f, 0.8f);  // 橙色：奖励房间
+            case Constants::RoomType::NORMAL:
+            default:
+                return Color4F(0.3f, 0.3f, 0.3f, 0.8f);  // 灰色：普通战斗房间
         }
     }
-}
-
-void MiniRoom::setDoorVisible(int direction, bool visible) {
-    if (direction >= 0 && direction < 4) {
-        _doors[direction]->setVisible(visible);
-        
-        if (visible) {
-            _doors[direction]->clear();
-            
-            float lineLength = 6.0f;
-            Vec2 start, end;
-            
-            switch (direction) {
-                case Constants::DIR_UP:
-                    start = Vec2(0, 8);
-                    end = Vec2(0, 8 + lineLength);
-                    break;
-                case Constants::DIR_RIGHT:
-                    start = Vec2(8, 0);
-                    end = Vec2(8 + lineLength, 0);
-                    break;
-                case Constants::DIR_DOWN:
-                    start = Vec2(0, -8);
-                    end = Vec2(0, -8 - lineLength);
-                    break;
-                case Constants::DIR_LEFT:
-                    start = Vec2(-8, 0);
-                    end = Vec2(-8 - lineLength, 0);
-                    break;
-            }
-            
-            _doors[direction]->drawLine(start, end, Color4F(0.6f, 0.6f, 0.6f, 0.8f));
+    
+    // 已访问的房间透明度降低到70%，显示为变暗效果
+    Color4F dimmed(Color4F color, bool visited) {
+        if (visited) {
+            color.a *= 180.0f / 255.0f;
         }
+        return color;
     }
 }
 
@@ -134,35 +43,49 @@ MiniMap* MiniMap::create() {
     return nullptr;
 }
 
+MiniMap::MiniMap()
+    : _gridSize(0)
+    , _canvas(nullptr)
+    , _renderTexture(nullptr)
+    , _dirty(false)
+{
+}
+
+MiniMap::~MiniMap() {
+    CC_SAFE_RELEASE_NULL(_canvas);
+}
+
 bool MiniMap::init() {
     if (!Node::init()) {
         return false;
     }
     
+    _gridSize = Constants::MAP_GRID_SIZE;
+    _miniRooms.assign(_gridSize * _gridSize, MiniRoom());
+    
     _roomSize = 16.0f;
     _gap = 6.0f;
-    _totalWidth = Constants::MAP_GRID_SIZE * (_roomSize + _gap);
-    _totalHeight = Constants::MAP_GRID_SIZE * (_roomSize + _gap);
+    _padding = 10.0f;
+    _totalWidth = _gridSize * (_roomSize + _gap);
+    _totalHeight = _gridSize * (_roomSize + _gap);
     
     _currentRoom = nullptr;
     _currentGridX = -1;
     _currentGridY = -1;
     
-    for (int y = 0; y < Constants::MAP_GRID_SIZE; y++) {
-        for (int x = 0; x < Constants::MAP_GRID_SIZE; x++) {
-            _miniRooms[x][y] = nullptr;
-        }
-    }
+    _canvas = DrawNode::create();
+    _canvas->retain();
     
-    auto background = DrawNode::create();
-    float bgPadding = 10.0f;
-    background->drawSolidRect(
-        Vec2(-bgPadding, -bgPadding),
-        Vec2(_totalWidth + bgPadding, _totalHeight + bgPadding),
-        Color4F(0.0f, 0.0f, 0.0f, 0.3f)
-    );
-    background->setGlobalZOrder(Constants::ZOrder::UI_GLOBAL);
-    this->addChild(background, -1);
+    // 合成纹理覆盖背景边距，整张小地图只占一次绘制
+    _renderTexture = RenderTexture::create(
+        (int)(_totalWidth + _padding * 2),
+        (int)(_totalHeight + _padding * 2),
+        backend::PixelFormat::RGBA8888);
+    _renderTexture->setPosition(Vec2(_totalWidth / 2, _totalHeight / 2));
+    _renderTexture->setGlobalZOrder(Constants::ZOrder::UI_GLOBAL);
+    _renderTexture->getSprite()->setGlobalZOrder(Constants::ZOrder::UI_GLOBAL);
+    this->addChild(_renderTexture, -1);
+    _dirty = true;
     
     Size visibleSize = Director::getInstance()->getVisibleSize();
     this->setPosition(Vec2(
@@ -183,44 +106,108 @@ bool MiniMap::init() {
     return true;
 }
 
-void MiniMap::initFromMapGenerator(MapGenerator* generator) {
-    if (!generator) return;
+void MiniMap::visit(Renderer* renderer, const Mat4& parentTransform, uint32_t parentFlags) {
+    // 只在状态变化后的下一帧重新合成一次
+    if (_dirty && _visible) {
+        redraw();
+    }
+    Node::visit(renderer, parentTransform, parentFlags);
+}
+
+void MiniMap::redraw() {
+    _dirty = false;
+    _canvas->clear();
+    
+    // 背景（纹理坐标系：原点在背景左下角）
+    _canvas->drawSolidRect(
+        Vec2::ZERO,
+        Vec2(_totalWidth + _padding * 2, _totalHeight + _padding * 2),
+        Color4F(0.0f, 0.0f, 0.0f, 0.3f)
+    );
+    
+    float half = _roomSize / 2;
+    float lineLength = 6.0f;
+    Color4F doorColor(0.6f, 0.6f, 0.6f, 0.8f);
     
-    for (int y = 0; y < Constants::MAP_GRID_SIZE; y++) {
-        for (int x = 0; x < Constants::MAP_GRID_SIZE; x++) {
-            if (_miniRooms[x][y]) {
-                _miniRooms[x][y]->removeFromParent();
-                _miniRooms[x][y] = nullptr;
+    for (int y = 0; y < _gridSize; y++) {
+        for (int x = 0; x < _gridSize; x++) {
+            const MiniRoom& room = _miniRooms[y * _gridSize + x];
+            if (!room.exists || !room.shown) continue;
+            
+            // 计算位置（不翻转Y轴）
+            Vec2 center(_padding + x * (_roomSize + _gap) + half,
+                        _padding + y * (_roomSize + _gap) + half);
+            
+            _canvas->drawSolidRect(center + Vec2(-half, -half), center + Vec2(half, half),
+                                   dimmed(roomColor(room.type), room.visited));
+            
+            Color4F borderColor = room.isCurrent ? Color4F::WHITE : Color4F(0.5f, 0.5f, 0.5f, 0.8f);
+            _canvas->drawRect(center + Vec2(-half, -half), center + Vec2(half, half),
+                              dimmed(borderColor, room.visited));
+            
+            for (int dir = 0; dir < Constants::DIR_COUNT; dir++) {
+                if (!room.doors[dir]) continue;
+                
+                Vec2 start, end;
+                switch (dir) {
+                    case Constants::DIR_UP:
+                        start = Vec2(0, half);
+                        end = Vec2(0, half + lineLength);
+                        break;
+                    case Constants::DIR_RIGHT:
+                        start = Vec2(half, 0);
+                        end = Vec2(half + lineLength, 0);
+                        break;
+                    case Constants::DIR_DOWN:
+                        start = Vec2(0, -half);
+                        end = Vec2(0, -half - lineLength);
+                        break;
+                    case Constants::DIR_LEFT:
+                        start = Vec2(-half, 0);
+                        end = Vec2(-half - lineLength, 0);
+                        break;
+                }
+                _canvas->drawLine(center + start, center + end, dimmed(doorColor, room.visited));
             }
         }
     }
     
-    for (int y = 0; y < Constants::MAP_GRID_SIZE; y++) {
-        for (int x = 0; x < Constants::MAP_GRID_SIZE; x++) {
+    _renderTexture->beginWithClear(0.0f, 0.0f, 0.0f, 0.0f);
+    _canvas->visit();
+    _renderTexture->end();
+}
+
+MiniRoom* MiniMap::roomAt(int x, int y) {
+    if (x < 0 || x >= _gridSize || y < 0 || y >= _gridSize) {
+        return nullptr;
+    }
+    return &_miniRooms[y * _gridSize + x];
+}
+
+void MiniMap::initFromMapGenerator(MapGenerator* generator) {
+    if (!generator) return;
+    
+    _miniRooms.assign(_gridSize * _gridSize, MiniRoom());
+    _currentGridX = -1;
+    _currentGridY = -1;
+    
+    for (int y = 0; y < _gridSize; y++) {
+        for (int x = 0; x < _gridSize; x++) {
             Room* room = generator->getRoom(x, y);
             if (room) {
-                MiniRoom* miniRoom = MiniRoom::create();
-                
-                // 计算位置（不翻转Y轴）
-                float posX = x * (_roomSize + _gap) + _roomSize / 2;
-                float posY = y * (_roomSize + _gap) + _roomSize / 2;
-                miniRoom->setPosition(Vec2(posX, posY));
-                
-                miniRoom->setRoomColor(room->getRoomType());
+                MiniRoom& miniRoom = _miniRooms[y * _gridSize + x];
+                miniRoom.exists = true;
+                miniRoom.type = room->getRoomType();
                 
                 for (int dir = 0; dir < Constants::DIR_COUNT; dir++) {
-                    miniRoom->setDoorVisible(dir, room->hasDoor(dir));
+                    miniRoom.doors[dir] = room->hasDoor(dir);
                 }
                 
-                if (room->getRoomType() != Constants::RoomType::BEGIN && !room->isVisited()) {
-                    miniRoom->setVisible(false);
-                }
-                
-                this->addChild(miniRoom);
-                _miniRooms[x][y] = miniRoom;
+                miniRoom.shown = room->getRoomType() == Constants::RoomType::BEGIN || room->isVisited();
             }
         }
     }
+    _dirty = true;
     
     Room* beginRoom = generator->getBeginRoom();
     if (beginRoom) {
@@ -231,23 +218,21 @@ void MiniMap::initFromMapGenerator(MapGenerator* generator) {
 void MiniMap::updateCurrentRoom(Room* currentRoom) {
     if (!currentRoom) return;
     
-    if (_currentGridX >= 0 && _currentGridY >= 0) {
-        MiniRoom* prevMiniRoom = _miniRooms[_currentGridX][_currentGridY];
-        if (prevMiniRoom) {
-            prevMiniRoom->setCurrent(false);
-            prevMiniRoom->setVisited(true);
-        }
+    MiniRoom* prevMiniRoom = roomAt(_currentGridX, _currentGridY);
+    if (prevMiniRoom) {
+        prevMiniRoom->isCurrent = false;
+        prevMiniRoom->visited = true;
     }
     
     _currentRoom = currentRoom;
     _currentGridX = currentRoom->getGridX();
     _currentGridY = currentRoom->getGridY();
     
-    MiniRoom* miniRoom = _miniRooms[_currentGridX][_currentGridY];
+    MiniRoom* miniRoom = roomAt(_currentGridX, _currentGridY);
     if (miniRoom) {
-        miniRoom->setVisible(true);
-        miniRoom->setCurrent(true);
-        miniRoom->setRoomColor(currentRoom->getRoomType());
+        miniRoom->shown = true;
+        miniRoom->isCurrent = true;
+        miniRoom->type = currentRoom->getRoomType();
         
         // 方向偏移数组
         static const int DIR_DX[] = {0, 1, 0, -1};
@@ -255,40 +240,30 @@ void MiniMap::updateCurrentRoom(Room* currentRoom) {
         
         for (int dir = 0; dir < Constants::DIR_COUNT; dir++) {
             if (currentRoom->hasDoor(dir)) {
-                int adjX = _currentGridX + DIR_DX[dir];
-                int adjY = _currentGridY + DIR_DY[dir];
-                
-                if (adjX >= 0 && adjX < Constants::MAP_GRID_SIZE &&
-                    adjY >= 0 && adjY < Constants::MAP_GRID_SIZE) {
-                    MiniRoom* adjMiniRoom = _miniRooms[adjX][adjY];
-                    if (adjMiniRoom) {
-                        adjMiniRoom->setVisible(true);
-                    }
+                MiniRoom* adjMiniRoom = roomAt(_currentGridX + DIR_DX[dir], _currentGridY + DIR_DY[dir]);
+                if (adjMiniRoom && adjMiniRoom->exists) {
+                    adjMiniRoom->shown = true;
                 }
             }
         }
     }
+    _dirty = true;
 }
 
 void MiniMap::updateRoomVisited(int gridX, int gridY) {
-    if (gridX < 0 || gridX >= Constants::MAP_GRID_SIZE ||
-        gridY < 0 || gridY >= Constants::MAP_GRID_SIZE) {
-        return;
-    }
-    
-    MiniRoom* miniRoom = _miniRooms[gridX][gridY];
-    if (miniRoom) {
-        miniRoom->setVisible(true);
-        miniRoom->setVisited(true);
+    MiniRoom* miniRoom = roomAt(gridX, gridY);
+    if (miniRoom && miniRoom->exists && !(miniRoom->shown && miniRoom->visited)) {
+        miniRoom->shown = true;
+        miniRoom->visited = true;
+        _dirty = true;
     }
 }
 
-MiniRoom* MiniMap::getMiniRoom(int x, int y) {
-    if (x < 0 || x >= Constants::MAP_GRID_SIZE || 
-        y < 0 || y >= Constants::MAP_GRID_SIZE) {
+const MiniRoom* MiniMap::getMiniRoom(int x, int y) const {
+    if (x < 0 || x >= _gridSize || y < 0 || y >= _gridSize) {
         return nullptr;
     }
-    return _miniRooms[x][y];
+    return &_miniRooms[y * _gridSize + x];
 }
 
 void MiniMap::updateLevelDisplay(int level, int stage) {
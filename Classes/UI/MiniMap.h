@@ -3,39 +3,28 @@
 
 #include "cocos2d.h"
 #include "Core/Constants.h"
+#include <vector>
 
 class MapGenerator;
 class Room;
 
-// MiniRoom - 小地图上的单个房间显示
-class MiniRoom : public cocos2d::Node {
-public:
-    static MiniRoom* create();
-    virtual bool init() override;
-    
-    // 设置房间类型颜色
-    void setRoomColor(Constants::RoomType type);
-    
-    // 设置为当前房间（高亮显示）
-    void setCurrent(bool isCurrent);
-    
-    // 设置已访问（灰色显示）
-    void setVisited(bool visited);
-    
-    // 设置门的可见性
-    void setDoorVisible(int direction, bool visible);
-    
-private:
-    cocos2d::DrawNode* _background;
-    cocos2d::DrawNode* _doors[4];  // 四个方向的门
-    bool _isCurrent;
+// MiniRoom - 小地图上单个房间的显示状态（纯数据，由 MiniMap 统一绘制）
+struct MiniRoom {
+    bool exists = false;      // 该格子是否有房间
+    bool shown = false;       // 是否已在小地图上显示
+    bool visited = false;     // 已访问（变暗显示）
+    bool isCurrent = false;   // 当前房间（白色边框）
+    Constants::RoomType type = Constants::RoomType::NORMAL;
+    bool doors[Constants::DIR_COUNT] = { false, false, false, false };
 };
 
 // MiniMap - 小地图UI组件 - 显示在屏幕右上角，展示房间布局
+// 所有房间先绘制到一张 RenderTexture，平时只画这一张纹理；状态变化时才重新合成
 class MiniMap : public cocos2d::Node {
 public:
     static MiniMap* create();
     virtual bool init() override;
+    virtual void visit(cocos2d::Renderer* renderer, const cocos2d::Mat4& parentTransform, uint32_t parentFlags) override;
     
     // 根据地图生成器初始化小地图
     void initFromMapGenerator(MapGenerator* generator);
@@ -46,16 +35,33 @@ public:
     // 更新房间访问状态
     void updateRoomVisited(int gridX, int gridY);
     
-    // 获取小地图房间
-    MiniRoom* getMiniRoom(int x, int y);
+    // 获取小地图房间状态
+    const MiniRoom* getMiniRoom(int x, int y) const;
+    
+protected:
+    MiniMap();
+    virtual ~MiniMap();
+    
+private:
+    MiniRoom* roomAt(int x, int y);
+    
+    // 把全部房间重新合成到 _renderTexture
+    void redraw();
     
 private:
-    // 5x5 小地图房间矩阵
-    MiniRoom* _miniRooms[Constants::MAP_GRID_SIZE][Constants::MAP_GRID_SIZE];
+    // 房间状态矩阵（_gridSize x _gridSize，按 y * _gridSize + x 存储）
+    std::vector<MiniRoom> _miniRooms;
+    int _gridSize;
+    
+    // 合成用的绘制节点（不挂在场景树上）与结果纹理
+    cocos2d::DrawNode* _canvas;
+    cocos2d::RenderTexture* _renderTexture;
+    bool _dirty;
     
     // 小地图配置
     float _roomSize;      // 每个房间的显示大小
     float _gap;           // 房间之间的间隙
+    float _padding;       // 背景边距
     float _totalWidth;    // 小地图总宽度
     float _totalHeight;   // 小地图总高度
     
@@ -0,0 +1,209 @@
+﻿#include "GameMetrics.h"
+#include "Entities/Enemy/Enemy.h"
+#include "Entities/Enemy/EnemyKinds.h"
+#include "Utils/TimerWheel.h"
+#include <typeinfo>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+GameMetrics::Snapshot GameMetrics::s_snapshot;
+GameMetrics::AIStats GameMetrics::s_pendingAI;
+int GameMetrics::s_pendingDamage = 0;
+bool GameMetrics::s_enabled = false;
+float GameMetrics::s_elapsed = 0.0f;
+GameMetrics::FrameStats GameMetrics::s_lastFrame;
+GameMetrics::FrameStats GameMetrics::s_worst;
+
+std::string GameMetrics::typeName(const Ref* obj)
+{
+    if (!obj) return "null";
+    const char* raw = typeid(*obj).name();
+#if defined(__GNUC__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(raw, nullptr, nullptr, &status);
+    if (status == 0 && demangled)
+    {
+        std::string name(demangled);
+        std::free(demangled);
+        return name;
+    }
+    return raw;
+#else
+    // MSVC: "class Du" / "struct Foo"
+    std::string name(raw);
+    if (name.compare(0, 6, "class ") == 0) return name.substr(6);
+    if (name.compare(0, 7, "struct ") == 0) return name.substr(7);
+    return name;
+#endif
+}
+
+void GameMetrics::visit(Node* node, Snapshot& out, const Node*& maxActionsNode)
+{
+    out.nodes++;
+    
+    ssize_t actions = node->getNumberOfRunningActions();
+    out.actions += static_cast<int>(actions);
+    if (actions > out.maxNodeActions)
+    {
+        // 类名只在遍历结束后解析一次
+        out.maxNodeActions = static_cast<int>(actions);
+        maxActionsNode = node;
+    }
+    
+    int tag = node->getTag();
+    if (tag == Constants::Tag::ENEMY)
+    {
+        if (auto enemy = Enemy::asEnemy(node))
+        {
+            if (!enemy->isDead())
+            {
+                out.enemies[static_cast<int>(enemy->getKind())]++;
+                out.enemyTotal++;
+            }
+        }
+    }
+    else if (tag == Constants::Tag::PROJECTILE)
+    {
+        out.projectiles++;
+    }
+    
+    // 按继承关系判断（Barrier 及其派生的 Spike、Box、Pillar 等都算作 Sprite）
+    if (dynamic_cast<Sprite*>(node)) out.sprites++;
+    else if (dynamic_cast<Label*>(node)) out.labels++;
+    else if (dynamic_cast<DrawNode*>(node)) out.drawNodes++;
+    
+    for (auto child : node->getChildren())
+    {
+        visit(child, out, maxActionsNode);
+    }
+}
+
+void GameMetrics::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+    s_elapsed = 0.0f;
+    s_lastFrame = FrameStats();
+    s_worst = FrameStats();
+    if (!enabled)
+    {
+        s_snapshot = Snapshot();
+    }
+}
+
+void GameMetrics::sample(Node* root, float dt)
+{
+    if (!s_enabled)
+    {
+        return;
+    }
+    
+    // dt 是上一帧开始到本帧开始的时间，即上一帧的耗时，与上一帧记录的计数对应
+    float frameMs = dt * 1000.0f;
+    if (frameMs > s_worst.frameMs)
+    {
+        s_worst = s_lastFrame;
+        s_worst.frameMs = frameMs;
+    }
+    s_lastFrame = currentFrame();
+    
+    s_elapsed += dt;
+    if (s_elapsed < SAMPLE_INTERVAL)
+    {
+        return;
+    }
+    s_elapsed = 0.0f;
+    
+    FrameStats worst = s_worst;
+    s_worst = FrameStats();
+    capture(root);
+    s_snapshot.worst = worst;
+}
+
+GameMetrics::FrameStats GameMetrics::currentFrame()
+{
+    FrameStats frame;
+    frame.actionsAll = static_cast<int>(Director::getInstance()->getActionManager()->getNumberOfRunningActions());
+    frame.timers = TimerWheel::getInstance()->getPendingCount();
+    frame.damage = s_pendingDamage;
+    frame.ai = s_pendingAI;
+    return frame;
+}
+
+void GameMetrics::capture(Node* root)
+{
+    Snapshot snapshot;
+    const Node* maxActionsNode = nullptr;
+    if (root)
+    {
+        visit(root, snapshot, maxActionsNode);
+    }
+    if (maxActionsNode)
+    {
+        snapshot.maxActionsNode = typeName(maxActionsNode);
+    }
+    snapshot.worst = currentFrame();
+    snapshot.worst.frameMs = Director::getInstance()->getDeltaTime() * 1000.0f;
+    s_snapshot = std::move(snapshot);
+}
+
+std::string GameMetrics::toDebugString()
+{
+    const Snapshot& s = s_snapshot;
+    const FrameStats& w = s.worst;
+    std::string text = StringUtils::format("Nodes: %d  Actions: %d  Enemies: %d  Proj: %d\nDrawNode: %d  Label: %d",
+                                           s.nodes, s.actions, s.enemyTotal, s.projectiles,
+                                           s.drawNodes, s.labels);
+    text += StringUtils::format("\nWorst %.1fms: Actions: %d  Timers: %d  Dmg: %d",
+                                w.frameMs, w.actionsAll, w.timers, w.damage);
+    text += StringUtils::format("\nAI: %d full  %d low  %d skip  %d frozen  %.2fms",
+                                w.ai.full, w.ai.reduced, w.ai.skipped, w.ai.frozen, w.ai.ms);
+    for (int i = 0; i < static_cast<int>(EnemyKind::COUNT); i++)
+    {
+        if (s.enemies[i] > 0)
+        {
+            text += StringUtils::format("\n  %s: %d", EnemyKinds::TABLE[i].name, s.enemies[i]);
+        }
+    }
+    return text;
+}
+
+std::string GameMetrics::toJson()
+{
+    const Snapshot& s = s_snapshot;
+    std::string json = "{";
+    const FrameStats& w = s.worst;
+    json += StringUtils::format("\"frameMs\":%.3f,\"nodes\":%d,\"actions\":%d,\"actionsAll\":%d,\"timers\":%d,\"damage\":%d,"
+                                "\"maxNodeActions\":%d,\"maxActionsNode\":\"%s\","
+                                "\"projectiles\":%d,\"drawNodes\":%d,\"labels\":%d,\"sprites\":%d,"
+                                "\"ai\":{\"full\":%d,\"reduced\":%d,\"skipped\":%d,\"frozen\":%d,\"ms\":%.3f},"
+                                "\"enemyTotal\":%d,\"enemies\":{",
+                                w.frameMs, s.nodes, s.actions, w.actionsAll, w.timers, w.damage,
+                                s.maxNodeActions, s.maxActionsNode.c_str(),
+                                s.projectiles, s.drawNodes, s.labels, s.sprites,
+                                w.ai.full, w.ai.reduced, w.ai.skipped, w.ai.frozen, w.ai.ms,
+                                s.enemyTotal);
+    bool first = true;
+    for (int i = 0; i < static_cast<int>(EnemyKind::COUNT); i++)
+    {
+        if (s.enemies[i] <= 0) continue;
+        if (!first) json += ",";
+        first = false;
+        json += StringUtils::format("\"%s\":%d", EnemyKinds::TABLE[i].name, s.enemies[i]);
+    }
+    json += "}}";
+    return json;
+}
+
+std::string GameMetrics::dumpToFile(const std::string& fileName)
+{
+    std::string path = FileUtils::getInstance()->getWritablePath() + fileName;
+    if (!FileUtils::getInstance()->writeStringToFile(toJson(), path))
+    {
+        GAME_LOG_ERROR("GameMetrics: failed to write %s", path.c_str());
+        return "";
+    }
+    GAME_LOG("GameMetrics: dumped to %s", path.c_str());
+    return path;
+}
@@ -0,0 +1,94 @@
+﻿#ifndef __GAME_METRICS_H__
+#define __GAME_METRICS_H__
+
+#include "cocos2d.h"
+#include "Core/Constants.h"
+#include "Core/GameMacros.h"
+#include <string>
+
+USING_NS_CC;
+
+// 运行时指标 - 开启后每帧记录廉价的计数（帧耗时、动作数、延迟回调、伤害、AI），并保留每个采样间隔内最慢的一帧；
+// 场景树（各类敌人、投射物、DrawNode、Label、节点总数）只在间隔结束时遍历一次
+// 结果供 HUD 调试面板显示，也可导出为 JSON 以便离线对比卡顿帧；默认关闭，仅调试构建可通过按键开启
+class GameMetrics {
+public:
+    // 敌人 AI 分级统计（GameScene::updateEnemies 每帧上报）
+    struct AIStats {
+        int full = 0;              // 全速执行
+        int reduced = 0;           // 低频轮到本帧执行
+        int skipped = 0;           // 低频本帧跳过
+        int frozen = 0;            // 不在当前房间，冻结
+        float ms = 0.0f;           // AI 总耗时
+    };
+    
+    // 单帧计数（开启时每帧记录，不遍历场景树）
+    struct FrameStats {
+        float frameMs = 0.0f;      // 该帧耗时
+        int actionsAll = 0;        // ActionManager 中的全部动作（含不在场景树中的节点）
+        int timers = 0;            // TimerWheel 中等待执行的延迟回调
+        int damage = 0;            // DamageQueue 结算的伤害事件
+        AIStats ai;
+    };
+    
+    struct Snapshot {
+        int enemies[static_cast<int>(EnemyKind::COUNT)] = {};   // 按 EnemyKind 统计存活数量
+        int enemyTotal = 0;
+        int projectiles = 0;       // Tag::PROJECTILE 节点
+        int drawNodes = 0;
+        int labels = 0;
+        int sprites = 0;
+        int nodes = 0;             // 场景树节点总数
+        int actions = 0;           // 场景树内节点上运行的动作
+        int maxNodeActions = 0;    // 单个节点上的最多动作数
+        std::string maxActionsNode;  // 对应节点的类名
+        FrameStats worst;          // 采样间隔内最慢的一帧及其计数（capture 时为当前帧）
+    };
+    
+    // 采样间隔（秒）
+    static constexpr float SAMPLE_INTERVAL = 0.5f;
+    
+    // 开关调试面板的指标采集（关闭时 sample 直接返回）
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return s_enabled; }
+    
+    // 每帧由 GameScene 调用一次；开启时记录本帧计数，每 SAMPLE_INTERVAL 秒才遍历一次场景树
+    static void sample(Node* root, float dt);
+    
+    // 立即遍历场景树生成快照（导出前调用，不受开关与采样间隔限制）
+    static void capture(Node* root);
+    
+    static const Snapshot& getSnapshot() { return s_snapshot; }
+    
+    // 上报本帧 AI 统计，本帧 sample 时记录
+    static void recordAI(const AIStats& stats) { s_pendingAI = stats; }
+    
+    // 上报本帧结算的伤害事件数
+    static void recordDamage(int events) { s_pendingDamage = events; }
+    
+    // HUD 调试面板用的简短文本
+    static std::string toDebugString();
+    
+    // 机器可读的 JSON 文本；dumpToFile 写入可写目录并返回完整路径
+    static std::string toJson();
+    static std::string dumpToFile(const std::string& fileName = "metrics.json");
+    
+    // 去掉编译器修饰的类名
+    static std::string typeName(const Ref* obj);
+    
+private:
+    static void visit(Node* node, Snapshot& out, const Node*& maxActionsNode);
+    
+    // 读取本帧的廉价计数（不含帧耗时）
+    static FrameStats currentFrame();
+    
+    static Snapshot s_snapshot;
+    static bool s_enabled;
+    static float s_elapsed;        // 距上次采样的累计时间
+    static FrameStats s_lastFrame; // 上一帧的计数（本帧的 dt 才是它的耗时）
+    static FrameStats s_worst;     // 本采样间隔内最慢一帧
+    static AIStats s_pendingAI;
+    static int s_pendingDamage;
+};
+
+#endif // __GAME_METRICS_H__
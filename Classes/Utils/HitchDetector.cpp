@@ -0,0 +1,107 @@
+﻿#include "HitchDetector.h"
+#include <algorithm>
+#include <vector>
+
+float HitchDetector::s_budgetMs = HitchDetector::DEFAULT_BUDGET_MS;
+
+namespace {
+    struct HitchRecord {
+        const char* name;
+        std::string detail;
+        float ms;
+        int depth;
+    };
+    
+    std::vector<HitchRecord> s_records;     // 本帧记录（每帧复用容量）
+    bool s_installed = false;
+    bool s_hasFrameStart = false;
+    int s_depth = 0;
+    std::chrono::steady_clock::time_point s_frameStart;
+    
+    // 报告中最多列出的操作数
+    const size_t MAX_REPORT_ENTRIES = 6;
+    // 单帧最多记录数（防止异常情况下无限增长）
+    const size_t MAX_RECORDS = 512;
+}
+
+void HitchDetector::install(float budgetMs)
+{
+    s_budgetMs = budgetMs;
+    if (s_installed) return;
+    s_installed = true;
+    s_records.reserve(64);
+    Director::getInstance()->getEventDispatcher()->addCustomEventListener(Director::EVENT_BEFORE_UPDATE,
+        [](EventCustom*) {
+            HitchDetector::onFrameBoundary();
+        });
+}
+
+int HitchDetector::enterScope()
+{
+    return s_depth++;
+}
+
+void HitchDetector::leaveScope()
+{
+    if (s_depth > 0) s_depth--;
+}
+
+void HitchDetector::record(const char* name, const std::string& detail, float ms, int depth)
+{
+    if (!s_installed || s_records.size() >= MAX_RECORDS) return;
+    s_records.push_back({ name, detail, ms, depth });
+}
+
+void HitchDetector::onFrameBoundary()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (!s_hasFrameStart)
+    {
+        s_hasFrameStart = true;
+        s_frameStart = now;
+        s_records.clear();
+        return;
+    }
+    
+    float frameMs = std::chrono::duration<float, std::milli>(now - s_frameStart).count();
+    s_frameStart = now;
+    
+    if (frameMs > s_budgetMs)
+    {
+        // 同名同细节的操作合并，按总耗时降序
+        struct Entry { std::string label; float ms; int count; };
+        std::vector<Entry> entries;
+        float tracked = 0.0f;
+        for (const auto& record : s_records)
+        {
+            if (record.depth == 0) tracked += record.ms;
+            std::string label = record.detail.empty() ? record.name : std::string(record.name) + ":" + record.detail;
+            auto it = std::find_if(entries.begin(), entries.end(), [&label](const Entry& e) { return e.label == label; });
+            if (it != entries.end())
+            {
+                it->ms += record.ms;
+                it->count++;
+            }
+            else
+            {
+                entries.push_back({ label, record.ms, 1 });
+            }
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.ms > b.ms; });
+        
+        std::string report = StringUtils::format("[HITCH] %.1f ms (budget %.0f)", frameMs, s_budgetMs);
+        for (size_t i = 0; i < entries.size() && i < MAX_REPORT_ENTRIES; i++)
+        {
+            report += StringUtils::format(" | %s %.1fms", entries[i].label.c_str(), entries[i].ms);
+            if (entries[i].count > 1) report += StringUtils::format(" x%d", entries[i].count);
+        }
+        if (entries.size() > MAX_REPORT_ENTRIES)
+        {
+            report += StringUtils::format(" | +%d more", (int)(entries.size() - MAX_REPORT_ENTRIES));
+        }
+        report += StringUtils::format(" | untracked %.1fms", std::max(0.0f, frameMs - tracked));
+        GAME_LOG("%s", report.c_str());
+    }
+    
+    s_records.clear();
+}
@@ -0,0 +1,69 @@
+﻿#ifndef __HITCH_DETECTOR_H__
+#define __HITCH_DETECTOR_H__
+
+#include "cocos2d.h"
+#include "Core/GameMacros.h"
+#include <chrono>
+#include <string>
+
+USING_NS_CC;
+
+// 卡顿检测 - 以 Director 的 EVENT_BEFORE_UPDATE 划分帧，帧耗时超过预算时输出本帧内被插桩操作的耗时汇总
+// 在可能卡顿的同步路径（敌人生成、房间构建、TTF Label 创建、音效同步预加载）上放置 HitchScope
+// 报告格式：[HITCH] 帧耗时 | 操作 耗时 x次数 | ... | 未插桩 耗时
+class HitchDetector {
+public:
+    static constexpr float DEFAULT_BUDGET_MS = 20.0f;
+    
+    // 注册帧边界监听（重复调用无副作用）
+    static void install(float budgetMs = DEFAULT_BUDGET_MS);
+    
+    static void setBudgetMs(float budgetMs) { s_budgetMs = budgetMs; }
+    static float getBudgetMs() { return s_budgetMs; }
+    
+    // 记录一次操作（由 HitchScope 调用）；depth 为 0 表示最外层操作
+    static void record(const char* name, const std::string& detail, float ms, int depth);
+    
+    // 当前嵌套深度（HitchScope 内部使用）
+    static int enterScope();
+    static void leaveScope();
+    
+private:
+    static void onFrameBoundary();
+    
+    static float s_budgetMs;
+};
+
+// 作用域计时：析构时把耗时记入当前帧
+class HitchScope {
+public:
+    explicit HitchScope(const char* name, const std::string& detail = "")
+    : _name(name)
+    , _detail(detail)
+    , _start(std::chrono::steady_clock::now())
+    , _depth(HitchDetector::enterScope())
+    {
+    }
+    
+    ~HitchScope()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - _start;
+        float ms = std::chrono::duration<float, std::milli>(elapsed).count();
+        HitchDetector::leaveScope();
+        HitchDetector::record(_name, _detail, ms, _depth);
+    }
+    
+    // 操作细节在作用域内才确定时使用（例如生成的敌人类型）
+    void setDetail(const std::string& detail) { _detail = detail; }
+    
+private:
+    HitchScope(const HitchScope&) = delete;
+    HitchScope& operator=(const HitchScope&) = delete;
+    
+    const char* _name;
+    std::string _detail;
+    std::chrono::steady_clock::time_point _start;
+    int _depth;
+};
+
+#endif // __HITCH_DETECTOR_H__
@@ -0,0 +1,66 @@
+﻿#include "InfluenceGrid.h"
+#include <cmath>
+
+InfluenceGrid::InfluenceGrid(float cellSize)
+    : _cellSize(cellSize)
+{
+}
+
+void InfluenceGrid::clear()
+{
+    for (auto cell : _touched)
+    {
+        cell->clear();
+    }
+    _touched.clear();
+    _influences.clear();
+}
+
+int InfluenceGrid::cellCoord(float v) const
+{
+    return static_cast<int>(std::floor(v / _cellSize));
+}
+
+void InfluenceGrid::insert(int id, float x, float y, float radius)
+{
+    int index = static_cast<int>(_influences.size());
+    _influences.push_back(Influence{ id, x, y, radius * radius });
+
+    int minX = cellCoord(x - radius);
+    int maxX = cellCoord(x + radius);
+    int minY = cellCoord(y - radius);
+    int maxY = cellCoord(y + radius);
+    for (int cx = minX; cx <= maxX; cx++)
+    {
+        for (int cy = minY; cy <= maxY; cy++)
+        {
+            std::vector<int>& cell = _cells[cellKey(cx, cy)];
+            if (cell.empty())
+            {
+                _touched.push_back(&cell);
+            }
+            cell.push_back(index);
+        }
+    }
+}
+
+int InfluenceGrid::findCovering(float x, float y) const
+{
+    auto it = _cells.find(cellKey(cellCoord(x), cellCoord(y)));
+    if (it == _cells.end())
+    {
+        return -1;
+    }
+
+    for (int index : it->second)
+    {
+        const Influence& influence = _influences[index];
+        float dx = x - influence.x;
+        float dy = y - influence.y;
+        if (dx * dx + dy * dy <= influence.radiusSq)
+        {
+            return influence.id;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,46 @@
+﻿#ifndef __INFLUENCE_GRID_H__
+#define __INFLUENCE_GRID_H__
+
+#include <vector>
+#include <unordered_map>
+
+// 半径影响的均匀网格索引
+// 每个影响（圆心 + 半径）登记到其包围盒覆盖的所有格子，点查询只检查所在格子中的候选。
+// 适合影响源少、每帧整体重建、点查询多的场景（例如 Cup 伤害分担光环）。
+// 不依赖 cocos2d。
+class InfluenceGrid {
+public:
+    explicit InfluenceGrid(float cellSize);
+
+    // 清空所有影响（格子容量保留，供下一次重建复用）
+    void clear();
+
+    // 登记一个影响，id 由调用方定义
+    void insert(int id, float x, float y, float radius);
+
+    // 返回覆盖 (x, y) 的影响中最先登记的一个的 id，没有时返回 -1
+    int findCovering(float x, float y) const;
+
+    int getCount() const { return static_cast<int>(_influences.size()); }
+
+private:
+    struct Influence {
+        int id;
+        float x;
+        float y;
+        float radiusSq;
+    };
+
+    int cellCoord(float v) const;
+    static unsigned long long cellKey(int cx, int cy)
+    {
+        return (static_cast<unsigned long long>(static_cast<unsigned int>(cx)) << 32) | static_cast<unsigned int>(cy);
+    }
+
+    float _cellSize;
+    std::vector<Influence> _influences;
+    std::unordered_map<unsigned long long, std::vector<int>> _cells;  // 格子 -> _influences 下标（按登记顺序）
+    std::vector<std::vector<int>*> _touched;                          // 本轮登记过的格子，clear 时只清这些
+};
+
+#endif // __INFLUENCE_GRID_H__
@@ -0,0 +1,149 @@
+﻿#include "LeakTracker.h"
+#include <map>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    std::unordered_map<Ref*, int> s_live;   // 存活对象 -> 创建时的场景代号
+    std::unordered_map<Ref*, std::vector<int>> s_retains;  // 手动 retain 的对象 -> 每次未抵消 retain 的场景代号
+    int s_generation = 0;
+    int s_checkTarget = 0;                  // 调度器需要一个稳定的 target 指针
+    
+    // 场景析构后等待子节点与自动释放池清空再检查
+    const float CHECK_DELAY = 1.0f;
+}
+
+int LeakTracker::beginGeneration()
+{
+    return ++s_generation;
+}
+
+void LeakTracker::endGeneration(int generation)
+{
+#ifdef COCOS2D_DEBUG
+    std::string key = StringUtils::format("LeakTracker::check_%d", generation);
+    Director::getInstance()->getScheduler()->schedule([generation](float) {
+        int leaked = LeakTracker::reportGeneration(generation);
+        if (leaked == 0)
+        {
+            GAME_LOG("LeakTracker: generation %d released cleanly (%d objects alive)",
+                     generation, LeakTracker::getLiveCount());
+        }
+    }, &s_checkTarget, 0.0f, 0, CHECK_DELAY, false, key);
+#endif
+}
+
+void LeakTracker::onCreate(Ref* obj)
+{
+    if (!obj) return;
+    s_live[obj] = s_generation;
+}
+
+void LeakTracker::onDestroy(Ref* obj)
+{
+    s_live.erase(obj);
+}
+
+void LeakTracker::onRetain(Ref* obj)
+{
+    if (!obj) return;
+    s_retains[obj].push_back(s_generation);
+}
+
+void LeakTracker::onRelease(Ref* obj)
+{
+    if (!obj) return;
+    auto it = s_retains.find(obj);
+    if (it == s_retains.end())
+    {
+        GAME_LOG_ERROR("LeakTracker: release without a tracked retain on %s", typeid(*obj).name());
+        return;
+    }
+    it->second.pop_back();
+    if (it->second.empty())
+    {
+        s_retains.erase(it);
+    }
+}
+
+int LeakTracker::getLiveCount()
+{
+    return static_cast<int>(s_live.size());
+}
+
+void LeakTracker::report()
+{
+    // 对象在析构时注销，表中的指针都仍然有效，可以取动态类型
+    std::map<std::pair<std::string, int>, int> groups;
+    for (const auto& pair : s_live)
+    {
+        groups[std::make_pair(std::string(typeid(*pair.first).name()), pair.second)]++;
+    }
+    // 未抵消的 retain 仍持有对象，同样可以取动态类型
+    std::map<std::pair<std::string, int>, int> retains;
+    for (const auto& pair : s_retains)
+    {
+        for (int generation : pair.second)
+        {
+            retains[std::make_pair(std::string(typeid(*pair.first).name()), generation)]++;
+        }
+    }
+    
+    GAME_LOG("LeakTracker: %d tracked objects alive", getLiveCount());
+    for (const auto& group : groups)
+    {
+        GAME_LOG("  gen %-3d %-32s x%d", group.first.second, group.first.first.c_str(), group.second);
+    }
+    for (const auto& group : retains)
+    {
+        GAME_LOG("  gen %-3d %-32s x%d retained", group.first.second, group.first.first.c_str(), group.second);
+    }
+    
+#if CC_REF_LEAK_DETECTION
+    // 引擎开启引用泄漏检测时，一并输出所有 Ref
+    Ref::printLeaks();
+#endif
+}
+
+int LeakTracker::reportGeneration(int generation)
+{
+    std::map<std::string, int> leaked;
+    int total = 0;
+    for (const auto& pair : s_live)
+    {
+        if (pair.second != generation) continue;
+        leaked[typeid(*pair.first).name()]++;
+        total++;
+    }
+    
+    std::map<std::string, int> retained;
+    int retainTotal = 0;
+    for (const auto& pair : s_retains)
+    {
+        for (int g : pair.second)
+        {
+            if (g != generation) continue;
+            retained[typeid(*pair.first).name()]++;
+            retainTotal++;
+        }
+    }
+    
+    if (total > 0)
+    {
+        GAME_LOG_ERROR("LeakTracker: %d objects of generation %d survived GameScene teardown", total, generation);
+        for (const auto& entry : leaked)
+        {
+            GAME_LOG_ERROR("  %-32s x%d", entry.first.c_str(), entry.second);
+        }
+    }
+    if (retainTotal > 0)
+    {
+        GAME_LOG_ERROR("LeakTracker: %d retains made in generation %d were never released", retainTotal, generation);
+        for (const auto& entry : retained)
+        {
+            GAME_LOG_ERROR("  %-32s x%d", entry.first.c_str(), entry.second);
+        }
+    }
+    return total + retainTotal;
+}
@@ -0,0 +1,51 @@
+﻿#ifndef __LEAK_TRACKER_H__
+#define __LEAK_TRACKER_H__
+
+#include "cocos2d.h"
+#include "Core/GameMacros.h"
+
+USING_NS_CC;
+
+// 调试用存活对象追踪 - 按类名与场景代号统计存活的 Ref，并在 GameScene 销毁后报告仍存活的对象
+// 每个 GameScene 构造时开启新一代；析构后延迟检查，此时该代对象应已全部释放
+// 追踪范围：GameEntity、MapGenerator、GameScene 的生命周期（CREATE/DESTROY），
+// 以及实体手动持有的 Animation（Mage、Gunner、Warrior、Cup、Boat、KuiLongBoss 的 retain/release 配对）
+// 仅在 COCOS2D_DEBUG 下通过下方的宏接入，Release 构建中没有任何开销
+class LeakTracker {
+public:
+    // 开启新的场景代号（GameScene 构造时调用）
+    static int beginGeneration();
+    
+    // 结束场景代号（GameScene 析构时调用），延迟检查该代的存活对象
+    static void endGeneration(int generation);
+    
+    static void onCreate(Ref* obj);
+    static void onDestroy(Ref* obj);
+    
+    // 手动 retain / release 配对：retain 时记下当前代号，release 时抵消一次
+    // 缓存类对象（Animation）不随场景销毁，只有未抵消的 retain 能说明持有者漏掉了 release
+    static void onRetain(Ref* obj);
+    static void onRelease(Ref* obj);
+    
+    // 输出所有存活对象（按类名与代号分组）
+    static void report();
+    
+    // 输出指定代号中仍存活的对象与未抵消的 retain，返回数量
+    static int reportGeneration(int generation);
+    
+    static int getLiveCount();
+};
+
+#ifdef COCOS2D_DEBUG
+    #define LEAK_TRACK_CREATE(obj) LeakTracker::onCreate(obj)
+    #define LEAK_TRACK_DESTROY(obj) LeakTracker::onDestroy(obj)
+    #define LEAK_TRACK_RETAIN(obj) LeakTracker::onRetain(obj)
+    #define LEAK_TRACK_RELEASE(obj) LeakTracker::onRelease(obj)
+#else
+    #define LEAK_TRACK_CREATE(obj)
+    #define LEAK_TRACK_DESTROY(obj)
+    #define LEAK_TRACK_RETAIN(obj)
+    #define LEAK_TRACK_RELEASE(obj)
+#endif
+
+#endif // __LEAK_TRACKER_H__
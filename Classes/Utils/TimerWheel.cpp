@@ -0,0 +1,291 @@
+﻿#include "TimerWheel.h"
+#include <algorithm>
+#include <cmath>
+
+TimerWheel* TimerWheel::_instance = nullptr;
+
+TimerWheel::Owner::~Owner()
+{
+    if (_head >= 0 && TimerWheel::_instance)
+    {
+        TimerWheel::_instance->cancelAll(*this);
+    }
+}
+
+TimerWheel* TimerWheel::getInstance()
+{
+    if (!_instance)
+    {
+        _instance = new TimerWheel();
+    }
+    return _instance;
+}
+
+void TimerWheel::destroyInstance()
+{
+    delete _instance;
+    _instance = nullptr;
+}
+
+TimerWheel::TimerWheel()
+    : _freeHead(-1)
+    , _pending(0)
+    , _now(0)
+    , _accum(0.0f)
+{
+    std::fill(std::begin(_heads), std::end(_heads), -1);
+    std::fill(std::begin(_tails), std::end(_tails), -1);
+}
+
+TimerWheel::~TimerWheel()
+{
+    // 未执行的回调只析构不执行；拥有者链表随之失效
+    for (int list = 0; list < LEVELS * SLOTS; list++)
+    {
+        for (int index = _heads[list]; index >= 0; index = at(index).next)
+        {
+            Timer& timer = at(index);
+            timer.destroy(timer.storage);
+            if (timer.owner)
+            {
+                timer.owner->_head = -1;
+            }
+        }
+    }
+}
+
+int TimerWheel::allocate()
+{
+    if (_freeHead < 0)
+    {
+        int base = static_cast<int>(_chunks.size()) * CHUNK_SIZE;
+        _chunks.emplace_back(new Timer[CHUNK_SIZE]);
+        for (int i = CHUNK_SIZE - 1; i >= 0; i--)
+        {
+            Timer& timer = at(base + i);
+            timer.generation = 0;
+            timer.list = -1;
+            timer.next = _freeHead;
+            _freeHead = base + i;
+        }
+    }
+    
+    int index = _freeHead;
+    _freeHead = at(index).next;
+    return index;
+}
+
+void TimerWheel::release(int index)
+{
+    Timer& timer = at(index);
+    timer.destroy(timer.storage);
+    timer.generation++;
+    timer.list = -1;
+    timer.next = _freeHead;
+    _freeHead = index;
+}
+
+TimerWheel::Handle TimerWheel::insert(int index, float delay, Owner* owner)
+{
+    // 按实际经过时间对齐：已累积的不足一刻度的时间计入延迟
+    static const uint64_t MAX_TICKS = (1ULL << (LEVEL_BITS * LEVELS)) - (1ULL << (LEVEL_BITS * (LEVELS - 1)));
+    float ticks = std::ceil((_accum + std::max(0.0f, delay)) / TICK_SECONDS - 0.001f);
+    uint64_t delta = static_cast<uint64_t>(std::max(1.0f, ticks));
+    
+    Timer& timer = at(index);
+    timer.expiry = _now + std::min(delta, MAX_TICKS);
+    timer.owner = owner;
+    link(index);
+    linkOwner(index);
+    _pending++;
+    
+    return (static_cast<Handle>(timer.generation) << 32) | static_cast<Handle>(index + 1);
+}
+
+int TimerWheel::find(Handle handle) const
+{
+    if (handle == INVALID_HANDLE)
+    {
+        return -1;
+    }
+    int index = static_cast<int>(handle & 0xFFFFFFFFu) - 1;
+    if (index < 0 || index >= static_cast<int>(_chunks.size()) * CHUNK_SIZE)
+    {
+        return -1;
+    }
+    const Timer& timer = at(index);
+    if (timer.list < 0 || timer.generation != static_cast<uint32_t>(handle >> 32))
+    {
+        return -1;
+    }
+    return index;
+}
+
+bool TimerWheel::cancel(Handle& handle)
+{
+    int index = find(handle);
+    handle = INVALID_HANDLE;
+    if (index < 0)
+    {
+        return false;
+    }
+    
+    unlink(index);
+    unlinkOwner(index);
+    release(index);
+    _pending--;
+    return true;
+}
+
+void TimerWheel::cancelAll(Owner& owner)
+{
+    while (owner._head >= 0)
+    {
+        int index = owner._head;
+        unlink(index);
+        unlinkOwner(index);
+        release(index);
+        _pending--;
+    }
+}
+
+bool TimerWheel::isPending(Handle handle) const
+{
+    return find(handle) >= 0;
+}
+
+void TimerWheel::tick(float dt)
+{
+    _accum += dt;
+    while (_accum >= TICK_SECONDS)
+    {
+        _accum -= TICK_SECONDS;
+        step();
+    }
+}
+
+void TimerWheel::link(int index)
+{
+    Timer& timer = at(index);
+    
+    // 放入与当前刻度共享更高位的最低一层；跨越最高层边界的放入最高层，下一轮到达时再下放
+    int level = LEVELS - 1;
+    for (int l = 0; l < LEVELS - 1; l++)
+    {
+        int shift = LEVEL_BITS * (l + 1);
+        if ((timer.expiry >> shift) == (_now >> shift))
+        {
+            level = l;
+            break;
+        }
+    }
+    int slot = static_cast<int>((timer.expiry >> (LEVEL_BITS * level)) & (SLOTS - 1));
+    int list = level * SLOTS + slot;
+    
+    timer.list = list;
+    timer.next = -1;
+    timer.prev = _tails[list];
+    if (_tails[list] >= 0)
+    {
+        at(_tails[list]).next = index;
+    }
+    else
+    {
+        _heads[list] = index;
+    }
+    _tails[list] = index;
+}
+
+void TimerWheel::unlink(int index)
+{
+    Timer& timer = at(index);
+    int list = timer.list;
+    
+    if (timer.prev >= 0) at(timer.prev).next = timer.next;
+    else _heads[list] = timer.next;
+    
+    if (timer.next >= 0) at(timer.next).prev = timer.prev;
+    else _tails[list] = timer.prev;
+    
+    timer.list = -1;
+}
+
+void TimerWheel::linkOwner(int index)
+{
+    Timer& timer = at(index);
+    timer.ownerPrev = -1;
+    timer.ownerNext = -1;
+    if (!timer.owner)
+    {
+        return;
+    }
+    
+    timer.ownerNext = timer.owner->_head;
+    if (timer.owner->_head >= 0)
+    {
+        at(timer.owner->_head).ownerPrev = index;
+    }
+    timer.owner->_head = index;
+}
+
+void TimerWheel::unlinkOwner(int index)
+{
+    Timer& timer = at(index);
+    if (!timer.owner)
+    {
+        return;
+    }
+    
+    if (timer.ownerPrev >= 0) at(timer.ownerPrev).ownerNext = timer.ownerNext;
+    else timer.owner->_head = timer.ownerNext;
+    
+    if (timer.ownerNext >= 0) at(timer.ownerNext).ownerPrev = timer.ownerPrev;
+    
+    timer.owner = nullptr;
+}
+
+void TimerWheel::step()
+{
+    _now++;
+    
+    // 低位归零的层需要把当前槽位下放，从高层往低层做，下放到本刻度槽位的会在同一刻度继续下放
+    for (int level = LEVELS - 1; level >= 1; level--)
+    {
+        uint64_t mask = (1ULL << (LEVEL_BITS * level)) - 1;
+        if ((_now & mask) == 0)
+        {
+            cascade(level);
+        }
+    }
+    
+    // 执行第 0 层当前槽位：先摘下再执行，回调中取消其它计时器或新建计时器都是安全的
+    int list = static_cast<int>(_now & (SLOTS - 1));
+    while (_heads[list] >= 0)
+    {
+        int index = _heads[list];
+        unlink(index);
+        unlinkOwner(index);
+        _pending--;
+        
+        // 回调可能析构拥有者或分配新块，但块内地址稳定，槽位在执行完后才回收
+        Timer& timer = at(index);
+        timer.invoke(timer.storage);
+        release(index);
+    }
+}
+
+void TimerWheel::cascade(int level)
+{
+    int slot = static_cast<int>((_now >> (LEVEL_BITS * level)) & (SLOTS - 1));
+    int list = level * SLOTS + slot;
+    
+    int index = _heads[list];
+    _heads[list] = -1;
+    _tails[list] = -1;
+    while (index >= 0)
+    {
+        int next = at(index).next;
+        link(index);
+        index = next;
+    }
+}
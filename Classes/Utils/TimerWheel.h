@@ -0,0 +1,118 @@
+﻿#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include "Core/GameMacros.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// 分层计时轮 - 替代 Sequence(DelayTime, CallFunc) 的玩法延迟回调
+// 4 层 x 64 槽，刻度 TICK_SECONDS；插入与取消 O(1)，回调就地存放在固定大小的槽里，不为单个计时器分配堆内存
+// 由 GameScene::update 推进，游戏暂停时不推进；回调在主线程、按到期刻度与插入顺序执行
+class TimerWheel {
+public:
+    typedef uint64_t Handle;
+    static constexpr Handle INVALID_HANDLE = 0;
+    
+    static constexpr float TICK_SECONDS = 0.01f;
+    static constexpr int LEVEL_BITS = 6;
+    static constexpr int SLOTS = 1 << LEVEL_BITS;
+    static constexpr int LEVELS = 4;
+    static constexpr size_t CALLBACK_SIZE = 48;   // 回调捕获上限（字节）
+    static constexpr int CHUNK_SIZE = 256;        // 计时器按块分配，块内地址稳定
+    
+    // 计时器拥有者：拥有者的全部计时器串成链表，cancelAll 一次取消；析构时自动取消
+    // 实体持有一个 Owner（见 GameEntity::scheduleTimer），场景级计时器使用 GameScene 的 Owner
+    class Owner {
+    public:
+        Owner() : _head(-1) {}
+        ~Owner();
+        bool hasTimers() const { return _head >= 0; }
+        
+    private:
+        Owner(const Owner&) = delete;
+        Owner& operator=(const Owner&) = delete;
+        
+        friend class TimerWheel;
+        int _head;
+    };
+    
+    static TimerWheel* getInstance();
+    static void destroyInstance();
+    
+    // delay 秒后执行 fn；owner 为空时计时器只能按句柄取消
+    template <typename F>
+    Handle schedule(float delay, Owner* owner, F fn)
+    {
+        static_assert(sizeof(F) <= CALLBACK_SIZE, "TimerWheel callback captures too much, capture pointers or ids instead");
+        static_assert(alignof(F) <= alignof(std::max_align_t), "TimerWheel callback is over-aligned");
+        
+        int index = allocate();
+        Timer& timer = at(index);
+        new (timer.storage) F(std::move(fn));
+        timer.invoke = [](void* p) { (*static_cast<F*>(p))(); };
+        timer.destroy = [](void* p) { static_cast<F*>(p)->~F(); };
+        return insert(index, delay, owner);
+    }
+    
+    // 取消并把句柄置为 INVALID_HANDLE；已执行或已取消的句柄返回 false
+    bool cancel(Handle& handle);
+    void cancelAll(Owner& owner);
+    bool isPending(Handle handle) const;
+    
+    // 推进 dt 秒，执行期间到期的回调
+    void tick(float dt);
+    
+    int getPendingCount() const { return _pending; }
+    
+private:
+    TimerWheel();
+    ~TimerWheel();
+    
+    struct Timer {
+        alignas(std::max_align_t) unsigned char storage[CALLBACK_SIZE];
+        void (*invoke)(void*);
+        void (*destroy)(void*);
+        uint64_t expiry;           // 到期刻度
+        Owner* owner;
+        int prev;                  // 槽位链表；空闲时 next 串起空闲链表
+        int next;
+        int ownerPrev;
+        int ownerNext;
+        int list;                  // 所在槽位 level * SLOTS + slot，-1 表示不在轮上
+        uint32_t generation;       // 每次释放递增，使旧句柄失效
+    };
+    
+    Timer& at(int index) { return _chunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+    const Timer& at(int index) const { return _chunks[index / CHUNK_SIZE][index % CHUNK_SIZE]; }
+    
+    int allocate();
+    void release(int index);
+    Handle insert(int index, float delay, Owner* owner);
+    int find(Handle handle) const;
+    
+    void link(int index);
+    void unlink(int index);
+    void linkOwner(int index);
+    void unlinkOwner(int index);
+    
+    void step();
+    void cascade(int level);
+    
+    static TimerWheel* _instance;
+    
+    std::vector<std::unique_ptr<Timer[]>> _chunks;
+    int _freeHead;
+    int _pending;
+    
+    int _heads[LEVELS * SLOTS];
+    int _tails[LEVELS * SLOTS];
+    
+    uint64_t _now;                 // 当前刻度
+    float _accum;                  // 不足一个刻度的剩余时间
+};
+
+#endif // __TIMER_WHEEL_H__
@@ -0,0 +1,225 @@
+﻿#include "VfxShapes.h"
+#include <cmath>
+
+namespace {
+    // 纹理中圆的半径（像素），纹理边长为其两倍
+    const int SHAPE_RADIUS = 128;
+    const int SHAPE_SIZE = SHAPE_RADIUS * 2;
+    
+    // 扇形描边宽度（像素）与填充不透明度（描边为 1.0）
+    const float FAN_OUTLINE_WIDTH = 4.0f;
+    const float FAN_FILL_ALPHA = 0.5f;
+    
+    struct VfxEntry {
+        Sprite* sprite = nullptr;
+        float elapsed = 0.0f;
+        float hold = 0.0f;
+        float fade = 0.0f;
+        float startOpacity = 255.0f;
+        bool active = false;
+    };
+    
+    static std::vector<VfxEntry> s_entries;     // 对象池（精灵由池 retain）
+    static std::vector<int> s_freeList;         // 空闲槽位下标
+    static int s_activeCount = 0;
+    static bool s_scheduled = false;
+    static int s_schedulerTarget = 0;
+    
+    // 把白色形状光栅化成预乘 alpha 纹理；coverage 返回像素中心处的覆盖率 [0, 1]
+    template <typename Coverage>
+    Texture2D* rasterize(const std::string& key, Coverage coverage)
+    {
+        auto textureCache = Director::getInstance()->getTextureCache();
+        Texture2D* texture = textureCache->getTextureForKey(key);
+        if (texture) return texture;
+        
+        std::vector<unsigned char> pixels(SHAPE_SIZE * SHAPE_SIZE * 4);
+        for (int y = 0; y < SHAPE_SIZE; y++)
+        {
+            for (int x = 0; x < SHAPE_SIZE; x++)
+            {
+                float px = x + 0.5f - SHAPE_RADIUS;
+                float py = SHAPE_RADIUS - (y + 0.5f);   // 图像行自上而下，翻转为 y 轴向上
+                float a = std::max(0.0f, std::min(1.0f, coverage(px, py)));
+                unsigned char v = static_cast<unsigned char>(a * 255.0f);
+                unsigned char* p = &pixels[(y * SHAPE_SIZE + x) * 4];
+                p[0] = v; p[1] = v; p[2] = v; p[3] = v;
+            }
+        }
+        
+        auto image = new (std::nothrow) Image();
+        if (!image) return nullptr;
+        image->initWithRawData(pixels.data(), (ssize_t)pixels.size(), SHAPE_SIZE, SHAPE_SIZE, 8, true);
+        texture = textureCache->addImage(image, key);
+        image->release();
+        return texture;
+    }
+    
+    void recycle(int index)
+    {
+        VfxEntry& entry = s_entries[index];
+        if (entry.sprite->getParent())
+        {
+            entry.sprite->removeFromParent();
+        }
+        entry.active = false;
+        s_freeList.push_back(index);
+        --s_activeCount;
+    }
+    
+    int acquireIndex()
+    {
+        if (!s_freeList.empty())
+        {
+            int index = s_freeList.back();
+            s_freeList.pop_back();
+            return index;
+        }
+        
+        auto sprite = Sprite::create();
+        if (!sprite) return -1;
+        sprite->retain();
+        VfxEntry entry;
+        entry.sprite = sprite;
+        s_entries.push_back(entry);
+        return (int)s_entries.size() - 1;
+    }
+    
+    void ensureScheduled()
+    {
+        if (s_scheduled) return;
+        s_scheduled = true;
+        Director::getInstance()->getScheduler()->schedule([](float dt) {
+            VfxShapes::update(dt);
+        }, &s_schedulerTarget, 0.0f, false, "VfxShapes::update");
+    }
+}
+
+Texture2D* VfxShapes::getDiscTexture()
+{
+    return rasterize("__vfx_disc", [](float px, float py) {
+        float dist = std::sqrt(px * px + py * py);
+        return SHAPE_RADIUS - dist;   // 边缘 1 像素抗锯齿
+    });
+}
+
+Texture2D* VfxShapes::getFanTexture(int angleDegrees)
+{
+    float halfAngle = CC_DEGREES_TO_RADIANS(angleDegrees * 0.5f);
+    return rasterize(StringUtils::format("__vfx_fan_%d", angleDegrees), [halfAngle](float px, float py) {
+        float dist = std::sqrt(px * px + py * py);
+        float inside = SHAPE_RADIUS - dist;
+        if (inside <= 0.0f) return 0.0f;
+        
+        // 与两条边的距离（点在扇形角度外时取负）
+        float angle = std::atan2(py, px);
+        float edgeAngle = halfAngle - std::fabs(angle);
+        float edgeDist = (edgeAngle >= (float)M_PI_2) ? dist : dist * std::sin(edgeAngle);
+        if (edgeDist <= -1.0f) return 0.0f;
+        
+        float coverage = std::min(1.0f, std::min(inside, edgeDist + 1.0f));
+        bool onOutline = inside < FAN_OUTLINE_WIDTH || edgeDist < FAN_OUTLINE_WIDTH;
+        return coverage * (onOutline ? 1.0f : FAN_FILL_ALPHA);
+    });
+}
+
+Sprite* VfxShapes::spawn(Node* parent, Texture2D* texture, const Vec2& pos, float radius, float rotation,
+                         const Color4F& color, float hold, float fade, int zOrder)
+{
+    if (!parent || !texture) return nullptr;
+    
+    int index = acquireIndex();
+    if (index < 0) return nullptr;
+    
+    VfxEntry& entry = s_entries[index];
+    Sprite* sprite = entry.sprite;
+    if (sprite->getTexture() != texture)
+    {
+        sprite->setTexture(texture);
+        sprite->setTextureRect(Rect(0, 0, SHAPE_SIZE, SHAPE_SIZE));
+    }
+    sprite->setPosition(pos);
+    sprite->setScale(radius / SHAPE_RADIUS);
+    sprite->setRotation(rotation);
+    sprite->setColor(Color3B(color));
+    sprite->setOpacity(static_cast<GLubyte>(color.a * 255.0f));
+    sprite->setVisible(true);
+    parent->addChild(sprite, zOrder);
+    
+    entry.elapsed = 0.0f;
+    entry.hold = hold;
+    entry.fade = fade;
+    entry.startOpacity = color.a * 255.0f;
+    entry.active = true;
+    ++s_activeCount;
+    
+    ensureScheduled();
+    return sprite;
+}
+
+Sprite* VfxShapes::spawnDisc(Node* parent, const Vec2& pos, float radius, const Color4F& color,
+                             float hold, float fade, int zOrder)
+{
+    return spawn(parent, getDiscTexture(), pos, radius, 0.0f, color, hold, fade, zOrder);
+}
+
+Sprite* VfxShapes::spawnFan(Node* parent, const Vec2& pos, float radius, float angleDegrees, float facingDegrees,
+                            const Color4F& color, float hold, float fade, int zOrder)
+{
+    // 张角取整作为缓存键，同一技能只光栅化一次；精灵旋转为顺时针，取反
+    int key = std::max(1, std::min(360, (int)std::lround(angleDegrees)));
+    return spawn(parent, getFanTexture(key), pos, radius, -facingDegrees, color, hold, fade, zOrder);
+}
+
+Sprite* VfxShapes::createDisc(float radius, const Color4F& color)
+{
+    auto sprite = Sprite::createWithTexture(getDiscTexture());
+    if (!sprite) return nullptr;
+    sprite->setScale(radius / SHAPE_RADIUS);
+    sprite->setColor(Color3B(color));
+    sprite->setOpacity(static_cast<GLubyte>(color.a * 255.0f));
+    return sprite;
+}
+
+void VfxShapes::prewarm(int count)
+{
+    getDiscTexture();
+    while ((int)s_entries.size() < count)
+    {
+        int index = acquireIndex();
+        if (index < 0) return;
+        s_freeList.push_back(index);
+    }
+}
+
+void VfxShapes::update(float dt)
+{
+    if (s_activeCount == 0) return;
+    
+    for (int i = 0; i < (int)s_entries.size(); i++)
+    {
+        VfxEntry& entry = s_entries[i];
+        if (!entry.active) continue;
+        
+        // 父节点已被销毁（例如切换场景），直接回收
+        if (entry.sprite->getParent() == nullptr)
+        {
+            recycle(i);
+            continue;
+        }
+        
+        entry.elapsed += dt;
+        float fadeElapsed = entry.elapsed - entry.hold;
+        if (fadeElapsed >= entry.fade)
+        {
+            recycle(i);
+            continue;
+        }
+        
+        if (fadeElapsed > 0.0f)
+        {
+            float alpha = 1.0f - fadeElapsed / entry.fade;
+            entry.sprite->setOpacity(static_cast<GLubyte>(entry.startOpacity * alpha));
+        }
+    }
+}
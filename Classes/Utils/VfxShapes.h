@@ -0,0 +1,38 @@
+﻿#ifndef __VFX_SHAPES_H__
+#define __VFX_SHAPES_H__
+
+#include "cocos2d.h"
+#include "Core/GameMacros.h"
+
+USING_NS_CC;
+
+// 特效形状缓存 - 圆盘 / 扇形只在首次使用时光栅化成纹理，之后以精灵缩放、着色、淡出复用
+// 一次性特效从对象池取精灵，由统一的帧更新驱动淡出并回收，生成时不再分配节点或重新细分几何
+class VfxShapes {
+public:
+    // 一次性圆盘：保持 hold 秒后在 fade 秒内淡出，结束后回收
+    // color.a 为初始不透明度；zOrder 为添加到 parent 时的层级（不设全局层级，以免打断合批）
+    static Sprite* spawnDisc(Node* parent, const Vec2& pos, float radius, const Color4F& color,
+                             float hold, float fade, int zOrder = 0);
+    
+    // 一次性扇形：以 facingDegrees（数学角度，逆时针）为中轴，张角 angleDegrees，边缘带描边
+    static Sprite* spawnFan(Node* parent, const Vec2& pos, float radius, float angleDegrees, float facingDegrees,
+                            const Color4F& color, float hold, float fade, int zOrder = 0);
+    
+    // 非池化圆盘（生命周期由调用方自己的动作管理，例如持续跟随的烟雾）
+    static Sprite* createDisc(float radius, const Color4F& color);
+    
+    // 预先创建一批池化精灵
+    static void prewarm(int count);
+    
+    // 推进所有一次性特效（由调度器每帧调用一次）
+    static void update(float dt);
+    
+private:
+    static Texture2D* getDiscTexture();
+    static Texture2D* getFanTexture(int angleDegrees);
+    static Sprite* spawn(Node* parent, Texture2D* texture, const Vec2& pos, float radius, float rotation,
+                         const Color4F& color, float hold, float fade, int zOrder);
+};
+
+#endif // __VFX_SHAPES_H__